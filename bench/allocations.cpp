@@ -0,0 +1,121 @@
+// Counts the allocations made by each phase of rendering the dashboard, as
+// main.cpp does: building the Element tree, measuring it with app::Measure(),
+// rendering it into a Screen of that size with app::RenderMeasured(), which
+// gives the boxes out and runs the passes asked for by Check(), and
+// serializing the Screen. Prints a report per frame.
+//
+// Usage: bench_allocations [frames] [maximum allocations per frame]
+// Exits with an error when a frame allocates more than the maximum, so that
+// a regression fails a script.
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#include "bench.hpp"
+#include "counting_new.hpp"
+#include "dashboard.hpp"
+#include "fit_render.hpp"
+#include "frame_encoder.hpp"
+#include "ftxui/screen/screen.hpp"
+#include "screen_pool.hpp"
+
+using namespace ftxui;
+
+namespace {
+
+struct Counts {
+  size_t allocations = 0;
+  size_t frees = 0;
+  size_t bytes = 0;
+
+  Counts& operator+=(const Counts& other) {
+    allocations += other.allocations;
+    frees += other.frees;
+    bytes += other.bytes;
+    return *this;
+  }
+};
+
+// Runs |function| and returns what it allocated and freed.
+template <class Function>
+Counts Count(Function function) {
+  Counts before = {bench::g_allocations, bench::g_frees, bench::g_bytes};
+  function();
+  return {bench::g_allocations - before.allocations,
+          bench::g_frees - before.frees, bench::g_bytes - before.bytes};
+}
+
+enum Phase { kBuild, kLayout, kRender, kSerialize, kPhases };
+const char* const kPhaseNames[kPhases] = {"build", "layout", "render",
+                                          "serialize"};
+
+void Print(const char* title, const Counts (&counts)[kPhases], size_t frames) {
+  Counts total;
+  std::printf("%s\n", title);
+  for (int phase = 0; phase < kPhases; ++phase) {
+    std::printf("  %-10s %8zu allocations %8zu frees %10zu bytes\n",
+                kPhaseNames[phase], counts[phase].allocations / frames,
+                counts[phase].frees / frames, counts[phase].bytes / frames);
+    total += counts[phase];
+  }
+  std::printf("  %-10s %8zu allocations %8zu frees %10zu bytes\n", "total",
+              total.allocations / frames, total.frees / frames,
+              total.bytes / frames);
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+  int frames = argc > 1 ? std::atoi(argv[1]) : 5;
+  size_t maximum = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+
+  app::Jobs jobs;
+  app::FrameEncoder encoder;
+  // The Screen is reused from one frame to the next, as in the live loops.
+  app::ScreenPool screens;
+  Counts all[kPhases];
+  size_t worst = 0;
+  for (int frame = 0; frame < frames; ++frame) {
+    app::Advance(jobs);
+    Counts counts[kPhases];
+    Element document;
+    Screen* screen = nullptr;
+    std::string output;
+
+    counts[kBuild] = Count([&] { document = app::Dashboard(jobs); });
+    counts[kLayout] = Count([&] {
+      int height =
+          app::Measure(document, {80, std::numeric_limits<int>::max()}).dimy;
+      screen = &screens.Get(80, height);
+    });
+    counts[kRender] = Count([&] { app::RenderMeasured(*screen, document); });
+    counts[kSerialize] = Count([&] {
+      output = screen->ToString();
+      output += encoder.Diff(*screen);
+    });
+    bench::DoNotOptimize(output);
+
+    // The tree and the output are freed at the end of the frame, outside the
+    // phases.
+    char title[32];
+    std::snprintf(title, sizeof(title), "frame %d", frame);
+    Print(title, counts, 1);
+
+    Counts total;
+    for (int phase = 0; phase < kPhases; ++phase) {
+      all[phase] += counts[phase];
+      total += counts[phase];
+    }
+    if (total.allocations > worst)
+      worst = total.allocations;
+  }
+  if (frames > 1)
+    Print("mean", all, frames);
+
+  if (maximum && worst > maximum) {
+    std::printf("%zu allocations in a frame, more than %zu\n", worst, maximum);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,37 @@
+#ifndef FTXUI_STARTER_BENCH_BENCH_HPP
+#define FTXUI_STARTER_BENCH_BENCH_HPP
+
+#include <chrono>
+#include <cstdio>
+
+namespace bench {
+
+// Runs |function| |iterations| times after a short warm up, and returns the
+// mean duration of one call in nanoseconds.
+template <class Function>
+double Measure(int iterations, Function function) {
+  for (int i = 0; i < iterations / 10 + 1; ++i)
+    function();
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    function();
+  auto end = std::chrono::steady_clock::now();
+
+  std::chrono::duration<double, std::nano> elapsed = end - start;
+  return elapsed.count() / iterations;
+}
+
+inline void Report(const char* name, double nanoseconds) {
+  std::printf("%-40s %12.0f ns\n", name, nanoseconds);
+}
+
+// Keeps the compiler from optimizing away a result.
+template <class T>
+void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace bench
+
+#endif  // FTXUI_STARTER_BENCH_BENCH_HPP
@@ -0,0 +1,97 @@
+// Serializes a full screen frame where every cell has its own RGB color, for
+// each color support, and compares it with searching the nearest palette
+// entry of every cell.
+#include "bench.hpp"
+#include "frame_encoder.hpp"
+
+using namespace ftxui;
+
+namespace {
+
+const int kWidth = 200;
+const int kHeight = 60;
+
+Screen ColorfulScreen() {
+  Screen screen(kWidth, kHeight);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      Pixel& pixel = screen.PixelAt(x, y);
+      pixel.character = "#";
+      pixel.foreground_color = Color::RGB(x * 255 / kWidth, y * 255 / kHeight,
+                                          (x + y) * 255 / (kWidth + kHeight));
+      if ((x / 8) % 3 == 0)
+        pixel.background_color = Color::Green;
+      else if ((x / 8) % 3 == 1)
+        pixel.background_color = Color::RedLight;
+      else
+        pixel.background_color = Color::Red;
+    }
+  }
+  return screen;
+}
+
+// What a serializer without tables would do for every cell.
+int NearestBySearch(int red, int green, int blue) {
+  static const int kLevels[6] = {0, 95, 135, 175, 215, 255};
+  int best = 0;
+  int best_distance = 1 << 30;
+  for (int index = 16; index < 232; ++index) {
+    int dr = kLevels[(index - 16) / 36] - red;
+    int dg = kLevels[(index - 16) / 6 % 6] - green;
+    int db = kLevels[(index - 16) % 6] - blue;
+    int distance = dr * dr + dg * dg + db * db;
+    if (distance < best_distance) {
+      best = index;
+      best_distance = distance;
+    }
+  }
+  return best;
+}
+
+}  // namespace
+
+int main() {
+  // Keep the colors in RGB, as the terminal server does.
+  Terminal::SetColorSupport(Terminal::TrueColor);
+  Screen screen = ColorfulScreen();
+
+  const struct {
+    const char* name;
+    Terminal::Color support;
+  } kModes[] = {
+      {"serialize: truecolor", Terminal::TrueColor},
+      {"serialize: 256 colors", Terminal::Palette256},
+      {"serialize: 16 colors", Terminal::Palette16},
+      {"serialize: monochrome", Terminal::Palette1},
+  };
+  for (const auto& mode : kModes) {
+    app::FrameEncoder encoder(mode.support);
+    encoder.Diff(screen);
+    size_t bytes = 0;
+    double ns = bench::Measure(200, [&] {
+      std::string frame = encoder.Full();
+      bytes = frame.size();
+      bench::DoNotOptimize(frame);
+    });
+    bench::Report(mode.name, ns);
+    std::printf("%-40s %12zu bytes\n", "", bytes);
+  }
+
+  bench::Report("lookup: 256 colors, per cell", bench::Measure(200, [&] {
+                  int sum = 0;
+                  for (int y = 0; y < kHeight; ++y) {
+                    for (int x = 0; x < kWidth; ++x)
+                      sum += app::NearestPalette256(x, y, x + y);
+                  }
+                  bench::DoNotOptimize(sum);
+                }));
+  bench::Report("search: 256 colors, per cell", bench::Measure(200, [&] {
+                  int sum = 0;
+                  for (int y = 0; y < kHeight; ++y) {
+                    for (int x = 0; x < kWidth; ++x)
+                      sum += NearestBySearch(x, y, x + y);
+                  }
+                  bench::DoNotOptimize(sum);
+                }));
+  return 0;
+}
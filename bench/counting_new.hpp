@@ -0,0 +1,40 @@
+#ifndef FTXUI_STARTER_BENCH_COUNTING_NEW_HPP
+#define FTXUI_STARTER_BENCH_COUNTING_NEW_HPP
+
+// Replaces the global operator new and delete with ones counting the
+// allocations, the bytes allocated and the frees of the program. The
+// replacements cannot be inline: include this header from one file only, the
+// one of a benchmark's main().
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace bench {
+
+inline size_t g_allocations = 0;
+inline size_t g_frees = 0;
+inline size_t g_bytes = 0;
+
+}  // namespace bench
+
+void* operator new(size_t size) {
+  ++bench::g_allocations;
+  bench::g_bytes += size;
+  if (void* p = std::malloc(size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  if (p)
+    ++bench::g_frees;
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  if (p)
+    ++bench::g_frees;
+  std::free(p);
+}
+
+#endif  // FTXUI_STARTER_BENCH_COUNTING_NEW_HPP
@@ -0,0 +1,62 @@
+// Sizes a Screen to a document of thousands of nested boxes and renders it,
+// with Dimension::Fit() and Render(), which compute the requirements of the
+// tree twice, and with Measure() and RenderMeasured(), which compute them
+// once.
+#include <string>
+
+#include "bench.hpp"
+#include "fit_render.hpp"
+#include "ftxui/dom/node.hpp"
+
+using namespace ftxui;
+
+namespace {
+
+const int kRows = 2000;
+const int kDepth = 500;
+
+// Rows of boxes within boxes, below a chain of boxes nested kDepth deep.
+Element Document() {
+  Element chain = text("innermost");
+  for (int i = 0; i < kDepth; ++i)
+    chain = vbox({hbox({chain}) | flex});
+
+  Elements rows = {chain};
+  for (int i = 0; i < kRows; ++i) {
+    rows.push_back(hbox({
+        text(std::to_string(i)),
+        vbox({text("name"), hbox({text("state"), filler()})}) | flex,
+        vbox({text("queued"), text("started")}) | border,
+    }));
+  }
+  return vbox(std::move(rows));
+}
+
+}  // namespace
+
+int main() {
+  const int kIterations = 200;
+  Element document = Document();
+  Dimensions size = app::Measure(document, {80, 100 * kRows});
+  Screen screen(size.dimx, size.dimy);
+
+  bench::Report("Dimension::Fit + Render", bench::Measure(kIterations, [&] {
+                  Dimensions fit = Dimension::Fit(document);
+                  bench::DoNotOptimize(fit);
+                  Render(screen, document);
+                  bench::DoNotOptimize(screen);
+                }));
+  bench::Report("Measure + RenderMeasured", bench::Measure(kIterations, [&] {
+                  Dimensions measured =
+                      app::Measure(document, {80, 100 * kRows});
+                  bench::DoNotOptimize(measured);
+                  app::RenderMeasured(screen, document);
+                  bench::DoNotOptimize(screen);
+                }));
+  bench::Report("requirements alone", bench::Measure(kIterations, [&] {
+                  document->ComputeRequirement();
+                  bench::DoNotOptimize(document);
+                }));
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+// Lays out an hbox of 1000 flex children with ftxui::hbox(), which
+// distributes the space every frame, and with flex_hbox(), which only does it
+// again when a child's requirement or the width changes.
+#include <string>
+
+#include "bench.hpp"
+#include "flex_layout.hpp"
+#include "ftxui/dom/node.hpp"
+
+using namespace ftxui;
+
+namespace {
+
+const int kChildren = 1000;
+
+Elements Children(int changed_width) {
+  Elements children;
+  for (int i = 0; i < kChildren; ++i)
+    children.push_back(text(i == 0 ? std::string(changed_width, 'x') : "x") |
+                       flex);
+  return children;
+}
+
+void Layout(Element& document) {
+  Box box;
+  box.x_min = 0;
+  box.x_max = 3 * kChildren - 1;
+  box.y_min = 0;
+  box.y_max = 0;
+  document->ComputeRequirement();
+  document->SetBox(box);
+}
+
+}  // namespace
+
+int main() {
+  const int kIterations = 2000;
+  app::FlexLayout cached;
+  app::FlexLayout changing;
+  int width = 1;
+
+  bench::Report("hbox: layout", bench::Measure(kIterations, [&] {
+                  Element document = hbox(Children(1));
+                  Layout(document);
+                  bench::DoNotOptimize(document);
+                }));
+  bench::Report("flex_hbox: layout, unchanged",
+                bench::Measure(kIterations, [&] {
+                  Element document = app::flex_hbox(Children(1), &cached);
+                  Layout(document);
+                  bench::DoNotOptimize(document);
+                }));
+  bench::Report("flex_hbox: layout, one child changed",
+                bench::Measure(kIterations, [&] {
+                  width = 3 - width;
+                  Element document =
+                      app::flex_hbox(Children(width), &changing);
+                  Layout(document);
+                  bench::DoNotOptimize(document);
+                }));
+
+  // Without building the children.
+  Element plain = hbox(Children(1));
+  Element flexible = app::flex_hbox(Children(1), &cached);
+  bench::Report("hbox: layout only", bench::Measure(kIterations, [&] {
+                  Layout(plain);
+                }));
+  bench::Report("flex_hbox: layout only", bench::Measure(kIterations, [&] {
+                  Layout(flexible);
+                }));
+  std::printf("%d distributions for %d unchanged layouts\n", cached.solves(),
+              2 * (kIterations + kIterations / 10 + 1));
+  return 0;
+}
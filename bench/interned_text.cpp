@@ -0,0 +1,75 @@
+// Builds and renders 1000 summary panels, with labels created by
+// ftxui::text() and with interned labels, and reports the time and the
+// memory allocated by each.
+#include "bench.hpp"
+#include "counting_new.hpp"
+#include "interned_text.hpp"
+
+using namespace ftxui;
+
+namespace {
+
+const int kPanels = 1000;
+
+Element TextPanel() {
+  return window(text(L" Summary "),
+                vbox({
+                    hbox({text(L"- done:   "), text(L"3") | bold}),
+                    hbox({text(L"- active: "), text(L"2") | bold}),
+                    hbox({text(L"- queue:  "), text(L"9") | bold}),
+                }));
+}
+
+Element InternedPanel() {
+  static const app::InternedText& kDone = app::Intern(L"- done:   ");
+  static const app::InternedText& kActive = app::Intern(L"- active: ");
+  static const app::InternedText& kQueue = app::Intern(L"- queue:  ");
+  static const app::InternedText& kTitle = app::Intern(L" Summary ");
+  return window(app::label(kTitle), vbox({
+                                        hbox({app::label(kDone),
+                                              text(L"3") | bold}),
+                                        hbox({app::label(kActive),
+                                              text(L"2") | bold}),
+                                        hbox({app::label(kQueue),
+                                              text(L"9") | bold}),
+                                    }));
+}
+
+template <class Panel>
+void Run(const char* name, Panel panel) {
+  size_t allocations = bench::g_allocations;
+  size_t bytes = bench::g_bytes;
+  Elements panels;
+  for (int i = 0; i < kPanels; ++i)
+    panels.push_back(panel());
+  auto document = vbox(std::move(panels));
+  std::printf("%s: %zu allocations, %zu bytes to build %d panels\n", name,
+              bench::g_allocations - allocations, bench::g_bytes - bytes,
+              kPanels);
+
+  auto screen = Screen(80, kPanels * 5);
+  allocations = bench::g_allocations;
+  bytes = bench::g_bytes;
+  Render(screen, document);
+  std::printf("%s: %zu allocations, %zu bytes to render them\n", name,
+              bench::g_allocations - allocations, bench::g_bytes - bytes);
+
+  bench::Report("  build", bench::Measure(100, [&] {
+                  Elements panels;
+                  for (int i = 0; i < kPanels; ++i)
+                    panels.push_back(panel());
+                  bench::DoNotOptimize(panels);
+                }));
+  bench::Report("  render", bench::Measure(100, [&] {
+                  Render(screen, document);
+                  bench::DoNotOptimize(screen);
+                }));
+}
+
+}  // namespace
+
+int main() {
+  Run("text", TextPanel);
+  Run("interned", InternedPanel);
+  return 0;
+}
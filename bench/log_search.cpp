@@ -0,0 +1,90 @@
+// Searches 100000 synthetic log lines for a regular expression, with the
+// memmem prefilter of LogSearch and with the regular expression alone.
+//
+// First checks that the literal required by a few patterns, escapes
+// included, is found in a line that each of them matches: a wrong literal
+// makes the prefilter drop matching lines. Exits with an error if not.
+#include <cstdio>
+#include <cstdlib>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench.hpp"
+#include "log_search.hpp"
+
+namespace {
+
+struct Case {
+  const char* pattern;
+  std::string_view line;
+};
+
+const Case kCases[] = {
+    {"error: .*timeout", "error: disk timeout"},
+    {"foo\\x41bar", "fooAbar"},
+    {"foo\\u0041bar", "fooAbar"},
+    {"x\\0y", std::string_view("x\0y", 3)},
+    {"(ab)\\1c", "ababc"},
+    {"\\[warn\\] disk", "[warn] disk"},
+    {"\\d+ ms", "120 ms"},
+};
+
+bool Check() {
+  bool ok = true;
+  for (const Case& test : kCases) {
+    std::string line(test.line);
+    bool literal = false;
+    std::string required =
+        app::RequiredLiteral(test.pattern, &literal).value_or("");
+    std::regex regex(test.pattern, std::regex::ECMAScript);
+    if (!std::regex_search(line, regex)) {
+      std::printf("%s: does not match its line\n", test.pattern);
+      ok = false;
+    } else if (line.find(required) == std::string::npos) {
+      std::printf("%s: the prefilter looks for \"%s\" and drops a match\n",
+                  test.pattern, required.c_str());
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+}  // namespace
+
+int main() {
+  if (!Check())
+    return EXIT_FAILURE;
+
+  const int kLines = 100000;
+  std::vector<std::string> lines;
+  for (int i = 0; i < kLines; ++i) {
+    const char* tag = i % 100 == 0 ? "error: disk timeout"
+                      : i % 10 == 0 ? "warning"
+                                    : "info";
+    lines.push_back(std::to_string(i) + " " + tag + " " +
+                    std::string(i % 200, 'x'));
+  }
+
+  const char* pattern = "error: .*timeout";
+  bool literal = false;
+  std::string required = app::RequiredLiteral(pattern, &literal).value_or("");
+  std::regex regex(pattern, std::regex::ECMAScript | std::regex::optimize);
+
+  bench::Report("regex on every line", bench::Measure(10, [&] {
+                  int matches = 0;
+                  for (const std::string& line : lines)
+                    matches += std::regex_search(line, regex);
+                  bench::DoNotOptimize(matches);
+                }));
+  bench::Report("prefilter, then regex", bench::Measure(10, [&] {
+                  int matches = 0;
+                  for (const std::string& line : lines) {
+                    if (line.find(required) != std::string::npos)
+                      matches += std::regex_search(line, regex);
+                  }
+                  bench::DoNotOptimize(matches);
+                }));
+  return EXIT_SUCCESS;
+}
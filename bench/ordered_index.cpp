@@ -0,0 +1,69 @@
+// Keeps a million jobs sorted by queue time while they change state, and
+// reads windows of the sorted and filtered views, compared with sorting the
+// rows again for every frame.
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "bench.hpp"
+#include "job_list.hpp"
+
+int main() {
+  const size_t kJobs = 1000000;
+  const int kWindow = 50;
+  app::JobList jobs = app::JobList::Synthetic(kJobs);
+
+  bench::Report("build queue time views", bench::Measure(1, [&] {
+                  app::JobList copy = app::JobList::Synthetic(kJobs);
+                  bench::DoNotOptimize(copy.Sorted(app::JobOrder::QueueTime));
+                }));
+  jobs.Sorted(app::JobOrder::QueueTime);
+
+  uint64_t random = 88172645463325252ull;
+  auto next = [&] {
+    random ^= random << 13;
+    random ^= random >> 7;
+    random ^= random << 17;
+    return random;
+  };
+
+  bench::Report("update: change state", bench::Measure(100000, [&] {
+                  jobs.SetState(next() % kJobs,
+                                static_cast<app::JobState>(next() % 3));
+                }));
+  bench::Report("update: requeue", bench::Measure(100000, [&] {
+                  size_t row = next() % kJobs;
+                  jobs.SetQueuedAt(row, jobs[row].queued_at + 1);
+                }));
+
+  std::vector<std::string> cells(app::JobColumns().size());
+  auto read_window = [&](std::optional<app::JobState> filter) {
+    app::TableRows rows =
+        app::JobRows(jobs, app::JobOrder::QueueTime, filter);
+    size_t first = next() % (rows.count - kWindow);
+    for (int i = 0; i < kWindow; ++i)
+      rows.format(first + i, cells);
+    bench::DoNotOptimize(cells);
+  };
+  bench::Report("window: all jobs by queue time",
+                bench::Measure(10000, [&] { read_window(std::nullopt); }));
+  bench::Report("window: active jobs by queue time",
+                bench::Measure(10000, [&] {
+                  read_window(app::JobState::Active);
+                }));
+
+  bench::Report("baseline: filter + sort every frame", bench::Measure(5, [&] {
+                  std::vector<size_t> rows;
+                  for (size_t row = 0; row < jobs.size(); ++row) {
+                    if (jobs[row].state == app::JobState::Active)
+                      rows.push_back(row);
+                  }
+                  std::sort(rows.begin(), rows.end(), [&](size_t a, size_t b) {
+                    return jobs[a].queued_at < jobs[b].queued_at;
+                  });
+                  for (int i = 0; i < kWindow; ++i)
+                    app::FormatJob(jobs[rows[i]], cells);
+                  bench::DoNotOptimize(cells);
+                }));
+  return 0;
+}
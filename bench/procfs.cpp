@@ -0,0 +1,55 @@
+// Samples the procfs collectors with 1000 extra processes running, and
+// reports the share of a core taken by sampling at 10 Hz.
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "bench.hpp"
+#include "procfs.hpp"
+
+int main() {
+  const int kProcesses = 1000;
+  const double kRate = 10;
+
+  std::vector<pid_t> children;
+  for (int i = 0; i < kProcesses; ++i) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      pause();
+      _exit(0);
+    }
+    if (pid > 0)
+      children.push_back(pid);
+  }
+
+  app::CpuCollector cpu;
+  app::MemoryCollector memory;
+  app::IoCollector io;
+  // Never rescans after the first sample.
+  app::ProcessCollector processes(1 << 30);
+  app::ProcessCollector rescanning(1);
+
+  double total = 0;
+  auto report = [&](const char* name, double nanoseconds) {
+    bench::Report(name, nanoseconds);
+    total += nanoseconds;
+  };
+  report("cpu", bench::Measure(1000, [&] { cpu.Sample(); }));
+  report("memory", bench::Measure(1000, [&] { memory.Sample(); }));
+  report("disk and network", bench::Measure(1000, [&] { io.Sample(); }));
+  report("processes", bench::Measure(100, [&] { processes.Sample(); }));
+  std::printf("%zu processes sampled\n", processes.count());
+  std::printf("%.2f%% of a core at %.0f Hz\n", total * kRate / 1e7, kRate);
+
+  bench::Report("processes, rescanning /proc",
+                bench::Measure(100, [&] { rescanning.Sample(); }));
+
+  for (pid_t pid : children)
+    kill(pid, SIGKILL);
+  for (pid_t pid : children)
+    waitpid(pid, nullptr, 0);
+  return 0;
+}
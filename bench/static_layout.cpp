@@ -0,0 +1,44 @@
+// Compares rendering the dashboard through the FTXUI DOM, which builds and
+// lays out the Element tree every frame, with the static layout, which only
+// writes the counters.
+#include "bench.hpp"
+#include "dashboard.hpp"
+
+using namespace ftxui;
+
+int main() {
+  const int kIterations = 10000;
+  app::Jobs jobs;
+
+  bench::Report("dynamic: build + layout + render",
+                bench::Measure(kIterations, [&] {
+                  app::Advance(jobs);
+                  auto document = app::Dashboard(jobs);
+                  auto screen = Screen::Create(Dimension::Fixed(80),
+                                               Dimension::Fit(document));
+                  Render(screen, document);
+                  bench::DoNotOptimize(screen);
+                }));
+
+  auto document = app::Dashboard(jobs);
+  auto screen = Screen::Create(Dimension::Fixed(80), Dimension::Fit(document));
+  bench::Report("dynamic: render only", bench::Measure(kIterations, [&] {
+                  Render(screen, document);
+                  bench::DoNotOptimize(screen);
+                }));
+
+  app::StaticLayout<app::DashboardLayout> dashboard(80);
+  bench::Report("static: write fields", bench::Measure(kIterations, [&] {
+                  app::Advance(jobs);
+                  Screen& frame = app::RenderDashboard(dashboard, jobs);
+                  bench::DoNotOptimize(frame);
+                }));
+
+  bench::Report("static: layout at a new width",
+                bench::Measure(kIterations, [&] {
+                  app::StaticLayout<app::DashboardLayout> layout(80);
+                  bench::DoNotOptimize(layout);
+                }));
+
+  return 0;
+}
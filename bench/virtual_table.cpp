@@ -0,0 +1,32 @@
+// Renders one frame of a job table scrolled to random positions, for lists of
+// growing sizes. The time per frame should not depend on the number of jobs.
+#include "bench.hpp"
+#include "job_list.hpp"
+
+using namespace ftxui;
+
+int main() {
+  for (size_t count : {size_t(1000), size_t(100000), size_t(2000000)}) {
+    app::JobList jobs = app::JobList::Synthetic(count);
+    app::TableState state;
+    Screen screen(80, 50);
+
+    // The first frame samples the rows to size the columns.
+    char name[64];
+    std::snprintf(name, sizeof(name), "%zu jobs: first frame", count);
+    bench::Report(name, bench::Measure(1, [&] {
+                    app::TableState fresh;
+                    Render(screen, app::JobTable(jobs, &fresh));
+                  }));
+
+    size_t row = 0;
+    std::snprintf(name, sizeof(name), "%zu jobs: scrolled frame", count);
+    bench::Report(name, bench::Measure(1000, [&] {
+                    row = (row * 7919 + 104729) % count;
+                    state.ScrollTo(row);
+                    Render(screen, app::JobTable(jobs, &state));
+                    bench::DoNotOptimize(screen);
+                  }));
+  }
+  return 0;
+}
@@ -0,0 +1,189 @@
+#include "browser_app.hpp"
+
+#include <emscripten.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string_view>
+
+#include "fit_render.hpp"
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/screen.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+// The counters move every second.
+constexpr double kAdvancePeriodMs = 1000;
+
+}  // namespace
+
+BrowserApp::BrowserApp() : encoder_(Terminal::TrueColor) {}
+
+int BrowserApp::Frame(double now_ms) {
+  ReadInput();
+  // A lone escape character is the Escape key once no input followed it for
+  // a while: there is no event loop to set a timeout on.
+  if (!parser_.escape_pending()) {
+    escape_since_ms_ = -1;
+  } else if (escape_since_ms_ < 0) {
+    escape_since_ms_ = now_ms;
+  } else if (now_ms - escape_since_ms_ >=
+             InputParser::kEscapeTimeout.count()) {
+    escape_since_ms_ = -1;
+    events_.clear();
+    parser_.FlushEscape(events_);
+    for (const Event& event : events_)
+      OnEvent(event);
+  }
+  if (next_advance_ms_ < 0)
+    next_advance_ms_ = now_ms + kAdvancePeriodMs;
+  if (now_ms >= next_advance_ms_) {
+    Advance(jobs_);
+    changed_ = true;
+    next_advance_ms_ = now_ms + kAdvancePeriodMs;
+  }
+  dirty_rows_ = 0;
+  if (changed_)
+    Draw();
+  return dirty_rows_;
+}
+
+void BrowserApp::Resize(int dimx, int dimy) {
+  dimx = std::max(1, dimx);
+  dimy = std::max(1, dimy);
+  if (dimx == dimx_ && dimy == dimy_)
+    return;
+  dimx_ = dimx;
+  dimy_ = dimy;
+  changed_ = true;
+}
+
+void BrowserApp::ReadInput() {
+  uint32_t read = input_indices_[0];
+  uint32_t write = input_indices_[1];
+  if (read == write)
+    return;
+
+  // At most two contiguous parts, before and after the end of the ring.
+  events_.clear();
+  while (read != write) {
+    uint32_t offset = read % kInputSize;
+    uint32_t size = std::min(write - read, kInputSize - offset);
+    parser_.Feed(std::string_view(
+                     reinterpret_cast<const char*>(&input_[offset]), size),
+                 events_);
+    read += size;
+  }
+  input_consumed_ += write - input_indices_[0];
+  input_indices_[0] = read;
+  escape_since_ms_ = -1;
+
+  for (const Event& event : events_)
+    OnEvent(event);
+}
+
+void BrowserApp::OnEvent(const Event& event) {
+  if (event == Event::Character(' ')) {
+    Advance(jobs_);
+    changed_ = true;
+  } else if (event == Event::Character('r')) {
+    jobs_ = Jobs();
+    changed_ = true;
+  }
+}
+
+void BrowserApp::Draw() {
+  changed_ = false;
+  double start = emscripten_get_now();
+
+  auto document = Dashboard(jobs_);
+  // Dimension::Full() would be FTXUI's fixed size for browsers.
+  int height = Measure(document, {dimx_, dimy_}).dimy;
+  Screen& screen = screens_.Get(dimx_, height);
+  RenderMeasured(screen, document);
+  if (use_cells_) {
+    dirty_rows_ = cells_.Update(screen);
+  } else {
+    // index.html hands the bytes to the terminal on the null character.
+    std::cout << encoder_.Diff(screen) << '\0' << std::flush;
+  }
+
+  last_frame_ms_ = emscripten_get_now() - start;
+  total_frame_ms_ += last_frame_ms_;
+  frames_++;
+}
+
+}  // namespace app
+
+namespace {
+
+app::BrowserApp& App() {
+  static app::BrowserApp browser_app;
+  return browser_app;
+}
+
+}  // namespace
+
+extern "C" {
+
+EMSCRIPTEN_KEEPALIVE int frame(double now_ms) {
+  return App().Frame(now_ms);
+}
+
+EMSCRIPTEN_KEEPALIVE double last_frame_ms() {
+  return App().last_frame_ms();
+}
+
+EMSCRIPTEN_KEEPALIVE double mean_frame_ms() {
+  return App().mean_frame_ms();
+}
+
+EMSCRIPTEN_KEEPALIVE void resize(int dimx, int dimy) {
+  App().Resize(dimx, dimy);
+}
+
+EMSCRIPTEN_KEEPALIVE void use_cells(int enabled) {
+  App().set_use_cells(enabled);
+}
+
+EMSCRIPTEN_KEEPALIVE const app::CellBuffer::Cell* cells() {
+  return App().cells().cells();
+}
+
+EMSCRIPTEN_KEEPALIVE int cells_dimx() {
+  return App().cells().dimx();
+}
+
+EMSCRIPTEN_KEEPALIVE int cells_dimy() {
+  return App().cells().dimy();
+}
+
+EMSCRIPTEN_KEEPALIVE const int32_t* dirty_rows() {
+  return App().cells().dirty_rows();
+}
+
+EMSCRIPTEN_KEEPALIVE uint8_t* input_ring() {
+  return App().input();
+}
+
+EMSCRIPTEN_KEEPALIVE uint32_t input_ring_size() {
+  return app::BrowserApp::kInputSize;
+}
+
+EMSCRIPTEN_KEEPALIVE uint32_t* input_indices() {
+  return App().input_indices();
+}
+
+EMSCRIPTEN_KEEPALIVE void read_input() {
+  App().ReadInput();
+}
+
+EMSCRIPTEN_KEEPALIVE double input_consumed() {
+  return App().input_consumed();
+}
+
+}  // extern "C"
@@ -0,0 +1,125 @@
+#ifndef FTXUI_STARTER_BROWSER_APP_HPP
+#define FTXUI_STARTER_BROWSER_APP_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "cell_buffer.hpp"
+#include "dashboard.hpp"
+#include "frame_encoder.hpp"
+#include "ftxui/component/event.hpp"
+#include "screen_pool.hpp"
+#include "terminal_input.hpp"
+
+namespace app {
+
+// The dashboard in the browser, driven by the page instead of a blocking main
+// loop: index.html calls the exported frame() function from
+// requestAnimationFrame. Nothing waits on the C++ side, so the module is
+// built without ASYNCIFY, which instruments every function that may be on the
+// stack of a blocking call.
+//
+// A frame only renders when the counters changed; the others return at once.
+//
+// Frames are written to stdout as ANSI escape sequences for xterm.js, or,
+// with set_use_cells(true), copied into a CellBuffer that the page reads from
+// the WebAssembly heap and draws itself: nothing is encoded nor parsed, and
+// only the rows that changed are drawn.
+//
+// Input goes through a ring buffer in the WebAssembly heap: the page copies
+// whatever the terminal produced into it, in one go, and advances the write
+// index; each frame consumes everything written since the last one. A paste
+// larger than the ring is consumed in as many calls to ReadInput() before the
+// frame. Space advances the counters, 'r' resets them.
+class BrowserApp {
+ public:
+  BrowserApp();
+
+  // Called by the page once per animation frame, |now_ms| being the
+  // timestamp given to the requestAnimationFrame callback. Returns the number
+  // of rows of cells() to draw again.
+  int Frame(double now_ms);
+
+  // Lays the next frames out for a |dimx| x |dimy| terminal. The page calls it
+  // at most once per animation frame, however fast the window is resized.
+  void Resize(int dimx, int dimy);
+
+  void set_use_cells(bool use_cells) { use_cells_ = use_cells; }
+  const CellBuffer& cells() const { return cells_; }
+
+  // Parses and handles the input written since the last call. Called by
+  // Frame(), and by the page when it has more input than the ring holds.
+  void ReadInput();
+
+  // Bytes of the input ring, a power of two.
+  static constexpr uint32_t kInputSize = 1 << 16;
+  uint8_t* input() { return input_.data(); }
+  // The read and the write index, in that order. They count bytes since the
+  // start and are taken modulo kInputSize, so that the ring is empty when
+  // they are equal and full when they differ by kInputSize.
+  uint32_t* input_indices() { return input_indices_; }
+  // Bytes of input consumed so far.
+  double input_consumed() const { return input_consumed_; }
+
+  // Time taken by the last rendered frame, and by all of them, in
+  // milliseconds.
+  double last_frame_ms() const { return last_frame_ms_; }
+  double mean_frame_ms() const {
+    return frames_ ? total_frame_ms_ / frames_ : 0;
+  }
+
+ private:
+  void OnEvent(const ftxui::Event& event);
+  void Draw();
+
+  FrameEncoder encoder_;
+  ScreenPool screens_;
+  CellBuffer cells_;
+  bool use_cells_ = false;
+  int dirty_rows_ = 0;
+  Jobs jobs_;
+  bool changed_ = true;
+  double next_advance_ms_ = -1;
+  // Until the page tells, the size FTXUI assumes for a browser terminal.
+  int dimx_ = 140;
+  int dimy_ = 43;
+
+  std::vector<uint8_t> input_ = std::vector<uint8_t>(kInputSize);
+  uint32_t input_indices_[2] = {0, 0};
+  double input_consumed_ = 0;
+  InputParser parser_;
+  // When the escape character kept by |parser_| was read, or -1.
+  double escape_since_ms_ = -1;
+  std::vector<ftxui::Event> events_;
+
+  int frames_ = 0;
+  double last_frame_ms_ = 0;
+  double total_frame_ms_ = 0;
+};
+
+}  // namespace app
+
+// The entry points of the page.
+extern "C" {
+int frame(double now_ms);
+double last_frame_ms();
+double mean_frame_ms();
+void resize(int dimx, int dimy);
+
+// The cell buffer, when enabled: |cells_dimx()| * |cells_dimy()| cells of 4
+// 32-bit words, and the indices of the rows to draw again.
+void use_cells(int enabled);
+const app::CellBuffer::Cell* cells();
+int cells_dimx();
+int cells_dimy();
+const int32_t* dirty_rows();
+
+// The input ring, see BrowserApp::input().
+uint8_t* input_ring();
+uint32_t input_ring_size();
+uint32_t* input_indices();
+void read_input();
+double input_consumed();
+}
+
+#endif  // FTXUI_STARTER_BROWSER_APP_HPP
@@ -0,0 +1,75 @@
+#include "cell_buffer.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+// Decodes the first code point of |text|, which is UTF-8. Combining
+// characters following it are dropped.
+uint32_t FirstCodepoint(const std::string& text) {
+  if (text.empty())
+    return 0;
+  auto byte = [&](size_t i) {
+    return i < text.size() ? static_cast<uint8_t>(text[i]) : 0x80;
+  };
+  uint8_t lead = byte(0);
+  if (lead < 0x80)
+    return lead;
+  if (lead < 0xE0)
+    return (lead & 0x1F) << 6 | (byte(1) & 0x3F);
+  if (lead < 0xF0)
+    return (lead & 0x0F) << 12 | (byte(1) & 0x3F) << 6 | (byte(2) & 0x3F);
+  return (lead & 0x07) << 18 | (byte(1) & 0x3F) << 12 |
+         (byte(2) & 0x3F) << 6 | (byte(3) & 0x3F);
+}
+
+}  // namespace
+
+CellBuffer::Cell CellBuffer::Convert(const Pixel& pixel) {
+  Cell cell;
+  cell.codepoint = FirstCodepoint(pixel.character);
+
+  const Color* colors[2] = {&pixel.foreground_color, &pixel.background_color};
+  uint32_t* rgb[2] = {&cell.foreground, &cell.background};
+  for (int i = 0; i < 2; ++i) {
+    if (*colors[i] != last_colors_[i]) {
+      last_colors_[i] = *colors[i];
+      last_rgb_[i] = ColorToRgb(*colors[i]);
+    }
+    *rgb[i] = last_rgb_[i];
+  }
+
+  cell.style = (pixel.bold ? kBold : 0) | (pixel.dim ? kDim : 0) |
+               (pixel.underlined ? kUnderlined : 0) |
+               (pixel.blink ? kBlink : 0) | (pixel.inverted ? kInverted : 0);
+  return cell;
+}
+
+int CellBuffer::Update(Screen& screen) {
+  bool resized = screen.dimx() != dimx_ || screen.dimy() != dimy_;
+  if (resized) {
+    dimx_ = screen.dimx();
+    dimy_ = screen.dimy();
+    cells_.assign(static_cast<size_t>(dimx_) * dimy_, Cell());
+  }
+
+  dirty_rows_.clear();
+  row_.resize(dimx_);
+  for (int y = 0; y < dimy_; ++y) {
+    for (int x = 0; x < dimx_; ++x)
+      row_[x] = Convert(screen.PixelAt(x, y));
+    auto first = cells_.begin() + static_cast<size_t>(y) * dimx_;
+    if (!resized && std::equal(row_.begin(), row_.end(), first))
+      continue;
+    std::copy(row_.begin(), row_.end(), first);
+    dirty_rows_.push_back(y);
+  }
+  return dirty_count();
+}
+
+}  // namespace app
@@ -0,0 +1,73 @@
+#ifndef FTXUI_STARTER_CELL_BUFFER_HPP
+#define FTXUI_STARTER_CELL_BUFFER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "color_quantizer.hpp"
+#include "ftxui/screen/color.hpp"
+#include "ftxui/screen/screen.hpp"
+
+namespace app {
+
+// A Screen copied into an array of fixed-size cells, for renderers reading
+// memory directly rather than parsing escape sequences: in the browser, the
+// page draws the cells straight from the WebAssembly heap. The rows that
+// changed since the previous frame are listed, so that only those are drawn
+// again.
+class CellBuffer {
+ public:
+  // Colors are 0xRRGGBB, or kDefaultColor for the terminal's default.
+  static constexpr uint32_t kDefaultColor = kDefaultRgb;
+
+  // Bits of Cell::style.
+  static constexpr uint32_t kBold = 1 << 0;
+  static constexpr uint32_t kDim = 1 << 1;
+  static constexpr uint32_t kUnderlined = 1 << 2;
+  static constexpr uint32_t kBlink = 1 << 3;
+  static constexpr uint32_t kInverted = 1 << 4;
+
+  // Four 32-bit words, so that the page can read the cells as an array of
+  // integers.
+  struct Cell {
+    // The first code point of the glyph, 0 for the cell covered by a wide
+    // glyph on its left.
+    uint32_t codepoint = ' ';
+    uint32_t foreground = kDefaultColor;
+    uint32_t background = kDefaultColor;
+    uint32_t style = 0;
+
+    bool operator==(const Cell&) const = default;
+  };
+  static_assert(sizeof(Cell) == 16, "Cells are read by the page as 4 words");
+
+  // Copies |screen| and lists the rows that differ from the previous copy.
+  // Every row is listed when the dimensions changed. Returns the number of
+  // rows listed.
+  int Update(ftxui::Screen& screen);
+
+  int dimx() const { return dimx_; }
+  int dimy() const { return dimy_; }
+  // |dimx()| * |dimy()| cells, row by row.
+  const Cell* cells() const { return cells_.data(); }
+  // Indices of the rows changed by the last Update().
+  const int32_t* dirty_rows() const { return dirty_rows_.data(); }
+  int dirty_count() const { return static_cast<int>(dirty_rows_.size()); }
+
+ private:
+  Cell Convert(const ftxui::Pixel& pixel);
+
+  int dimx_ = 0;
+  int dimy_ = 0;
+  std::vector<Cell> cells_;
+  std::vector<Cell> row_;
+  std::vector<int32_t> dirty_rows_;
+
+  // The last colors converted: consecutive cells usually share them.
+  ftxui::Color last_colors_[2];
+  uint32_t last_rgb_[2] = {kDefaultColor, kDefaultColor};
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_CELL_BUFFER_HPP
@@ -0,0 +1,249 @@
+#include "color_quantizer.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+// The first 16 colors of xterm's palette. Terminals usually let users
+// customize them, so RGB colors are only mapped to them as a last resort.
+constexpr uint8_t kPalette16[16][3] = {
+    {0, 0, 0},       {205, 0, 0},     {0, 205, 0},     {205, 205, 0},
+    {0, 0, 238},     {205, 0, 205},   {0, 205, 205},   {229, 229, 229},
+    {127, 127, 127}, {255, 0, 0},     {0, 255, 0},     {255, 255, 0},
+    {92, 92, 255},   {255, 0, 255},   {0, 255, 255},   {255, 255, 255},
+};
+
+constexpr uint8_t kCubeLevels[6] = {0, 95, 135, 175, 215, 255};
+
+void Palette256Rgb(int index, int rgb[3]) {
+  if (index < 16) {
+    for (int i = 0; i < 3; ++i)
+      rgb[i] = kPalette16[index][i];
+  } else if (index < 232) {
+    index -= 16;
+    rgb[0] = kCubeLevels[index / 36];
+    rgb[1] = kCubeLevels[index / 6 % 6];
+    rgb[2] = kCubeLevels[index % 6];
+  } else {
+    rgb[0] = rgb[1] = rgb[2] = 8 + 10 * (index - 232);
+  }
+}
+
+int Distance(const int a[3], const int b[3]) {
+  int distance = 0;
+  for (int i = 0; i < 3; ++i)
+    distance += (a[i] - b[i]) * (a[i] - b[i]);
+  return distance;
+}
+
+int Nearest(const int rgb[3], int first, int last) {
+  int best = first;
+  int best_distance = -1;
+  for (int index = first; index < last; ++index) {
+    int candidate[3];
+    Palette256Rgb(index, candidate);
+    int distance = Distance(rgb, candidate);
+    if (best_distance < 0 || distance < best_distance) {
+      best = index;
+      best_distance = distance;
+    }
+  }
+  return best;
+}
+
+constexpr int kBits = 5;
+constexpr int kLevels = 1 << kBits;
+
+int Key(uint8_t red, uint8_t green, uint8_t blue) {
+  const int shift = 8 - kBits;
+  return (red >> shift) << (2 * kBits) | (green >> shift) << kBits |
+         (blue >> shift);
+}
+
+struct Tables {
+  uint8_t rgb_to_256[kLevels * kLevels * kLevels];
+  uint8_t rgb_to_16[kLevels * kLevels * kLevels];
+  uint8_t palette256_to_16[256];
+
+  Tables() {
+    const int shift = 8 - kBits;
+    for (int r = 0; r < kLevels; ++r) {
+      for (int g = 0; g < kLevels; ++g) {
+        for (int b = 0; b < kLevels; ++b) {
+          // The center of the cell of RGB values sharing this key.
+          int rgb[3] = {
+              r << shift | 1 << (shift - 1),
+              g << shift | 1 << (shift - 1),
+              b << shift | 1 << (shift - 1),
+          };
+          int key = r << (2 * kBits) | g << kBits | b;
+          rgb_to_256[key] = Nearest(rgb, 16, 256);
+          rgb_to_16[key] = Nearest(rgb, 0, 16);
+        }
+      }
+    }
+
+    for (int index = 0; index < 256; ++index) {
+      int rgb[3];
+      Palette256Rgb(index, rgb);
+      palette256_to_16[index] = index < 16 ? index : Nearest(rgb, 0, 16);
+    }
+  }
+};
+
+const Tables& GetTables() {
+  static const Tables tables;
+  return tables;
+}
+
+// Hashes the representation of |color|. Colors comparing equal have the same
+// representation, and a collision only costs a conversion.
+size_t Slot(const Color& color) {
+  static_assert(std::is_trivially_copyable<Color>::value,
+                "Colors are hashed byte by byte");
+  unsigned char bytes[sizeof(Color)];
+  std::memcpy(bytes, &color, sizeof(Color));
+  uint32_t hash = 2166136261u;
+  for (unsigned char byte : bytes)
+    hash = (hash ^ byte) * 16777619u;
+  return (hash ^ hash >> 16) & 255;
+}
+
+// ftxui::Color keeps its components private. Its SGR parameters hold them:
+// "39", "31", "91", "38;5;<index>" or "38;2;<red>;<green>;<blue>", with
+// 4x, 10x and 48 for backgrounds. Splits them into |values|, and returns how
+// many there are, at most 5.
+int ParseCodes(const std::string& codes, int values[5]) {
+  int count = 0;
+  for (const char* p = codes.c_str(); *p && count < 5; ++count) {
+    char* end;
+    values[count] = static_cast<int>(std::strtol(p, &end, 10));
+    p = *end == ';' ? end + 1 : end;
+  }
+  return count;
+}
+
+std::string Palette16Code(int index, bool background) {
+  int base = index < 8 ? 30 : 90 - 8;
+  return std::to_string(base + index + (background ? 10 : 0));
+}
+
+}  // namespace
+
+Terminal::Color DetectColorSupport(const char* term, const char* colorterm) {
+  std::string_view name = term ? term : "";
+  std::string_view color_term = colorterm ? colorterm : "";
+
+  if (color_term == "truecolor" || color_term == "24bit" ||
+      name.find("direct") != std::string_view::npos) {
+    return Terminal::TrueColor;
+  }
+  if (name.find("256") != std::string_view::npos)
+    return Terminal::Palette256;
+  if (name.empty() || name == "dumb")
+    return Terminal::Palette1;
+  return Terminal::Palette16;
+}
+
+Terminal::Color DetectColorSupport() {
+  return DetectColorSupport(std::getenv("TERM"), std::getenv("COLORTERM"));
+}
+
+bool ParseColorSupport(std::string_view text, Terminal::Color* support) {
+  if (text == "2")
+    *support = Terminal::Palette1;
+  else if (text == "16")
+    *support = Terminal::Palette16;
+  else if (text == "256")
+    *support = Terminal::Palette256;
+  else if (text == "truecolor" || text == "24bit")
+    *support = Terminal::TrueColor;
+  else
+    return false;
+  return true;
+}
+
+uint8_t NearestPalette256(uint8_t red, uint8_t green, uint8_t blue) {
+  return GetTables().rgb_to_256[Key(red, green, blue)];
+}
+
+uint8_t NearestPalette16(uint8_t red, uint8_t green, uint8_t blue) {
+  return GetTables().rgb_to_16[Key(red, green, blue)];
+}
+
+uint8_t Palette256ToPalette16(uint8_t index) {
+  return GetTables().palette256_to_16[index];
+}
+
+uint32_t ColorToRgb(const Color& color) {
+  int values[5] = {};
+  int count = ParseCodes(color.Print(false), values);
+
+  int rgb[3];
+  if (count == 5 && values[1] == 2) {
+    rgb[0] = values[2];
+    rgb[1] = values[3];
+    rgb[2] = values[4];
+  } else if (count == 3 && values[1] == 5) {
+    Palette256Rgb(values[2], rgb);
+  } else if (values[0] >= 30 && values[0] <= 37) {
+    Palette256Rgb(values[0] - 30, rgb);
+  } else if (values[0] >= 90 && values[0] <= 97) {
+    Palette256Rgb(values[0] - 90 + 8, rgb);
+  } else {
+    return kDefaultRgb;
+  }
+  return static_cast<uint32_t>(rgb[0]) << 16 | rgb[1] << 8 | rgb[2];
+}
+
+ColorQuantizer::ColorQuantizer(Terminal::Color support) : support_(support) {}
+
+void ColorQuantizer::Append(std::string& out,
+                            const Color& color,
+                            bool background) {
+  Entry& entry = recent_[Slot(color)];
+  if (entry.color != color) {
+    entry.color = color;
+    entry.codes[0].clear();
+    entry.codes[1].clear();
+  }
+  std::string& codes = entry.codes[background];
+  if (codes.empty())
+    codes = Convert(color, background);
+  out += codes;
+}
+
+std::string ColorQuantizer::Convert(const Color& color, bool background) const {
+  std::string codes = color.Print(background);
+  if (support_ == Terminal::TrueColor)
+    return codes;
+  if (support_ == Terminal::Palette1)
+    return background ? "49" : "39";
+
+  int values[5] = {};
+  int count = ParseCodes(codes, values);
+
+  if (count == 5 && values[1] == 2) {
+    uint8_t red = values[2];
+    uint8_t green = values[3];
+    uint8_t blue = values[4];
+    if (support_ == Terminal::Palette256) {
+      return (background ? "48;5;" : "38;5;") +
+             std::to_string(NearestPalette256(red, green, blue));
+    }
+    return Palette16Code(NearestPalette16(red, green, blue), background);
+  }
+
+  if (count == 3 && values[1] == 5 && support_ == Terminal::Palette16)
+    return Palette16Code(Palette256ToPalette16(values[2]), background);
+
+  return codes;
+}
+
+}  // namespace app
@@ -0,0 +1,70 @@
+#ifndef FTXUI_STARTER_COLOR_QUANTIZER_HPP
+#define FTXUI_STARTER_COLOR_QUANTIZER_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "ftxui/screen/color.hpp"
+#include "ftxui/screen/terminal.hpp"
+
+namespace app {
+
+// Guesses the colors a terminal supports from its TERM and COLORTERM
+// environment variables. Either can be null.
+ftxui::Terminal::Color DetectColorSupport(const char* term,
+                                          const char* colorterm);
+
+// Same, for the terminal this program runs in.
+ftxui::Terminal::Color DetectColorSupport();
+
+// Parses a color support given as "2", "16", "256" or "truecolor". Returns
+// false when |text| is none of these.
+bool ParseColorSupport(std::string_view text, ftxui::Terminal::Color* support);
+
+// Nearest entries of the xterm palettes, read from tables computed once per
+// program. The RGB tables have 5 bits of precision per channel.
+uint8_t NearestPalette256(uint8_t red, uint8_t green, uint8_t blue);
+uint8_t NearestPalette16(uint8_t red, uint8_t green, uint8_t blue);
+uint8_t Palette256ToPalette16(uint8_t index);
+
+// Value of ColorToRgb() for the terminal's default color.
+constexpr uint32_t kDefaultRgb = 0xFF000000;
+
+// The RGB value of |color| as 0xRRGGBB, palette colors taken from xterm's
+// default palette, or kDefaultRgb.
+uint32_t ColorToRgb(const ftxui::Color& color);
+
+// Converts Colors into SGR parameters for a terminal supporting fewer colors
+// than they were defined with. Conversions are table lookups, and the last
+// colors converted are remembered, so that encoding a frame costs no color
+// distance computation.
+class ColorQuantizer {
+ public:
+  explicit ColorQuantizer(
+      ftxui::Terminal::Color support = ftxui::Terminal::TrueColor);
+
+  // Appends the SGR parameters selecting |color| as the foreground or the
+  // background color, e.g. "38;5;196".
+  void Append(std::string& out, const ftxui::Color& color, bool background);
+
+  ftxui::Terminal::Color support() const { return support_; }
+
+ private:
+  struct Entry {
+    ftxui::Color color;
+    // Foreground and background parameters, empty until first needed.
+    std::string codes[2];
+  };
+
+  std::string Convert(const ftxui::Color& color, bool background) const;
+
+  ftxui::Terminal::Color support_;
+  // Direct mapped cache of the conversions.
+  std::array<Entry, 256> recent_;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_COLOR_QUANTIZER_HPP
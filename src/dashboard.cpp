@@ -0,0 +1,84 @@
+#include "dashboard.hpp"
+
+#include <charconv>
+#include <string>
+
+#include "interned_text.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+void Advance(Jobs& jobs) {
+  if (jobs.active > 0) {
+    jobs.active--;
+    jobs.done++;
+  }
+  if (jobs.queue > 0) {
+    jobs.queue--;
+    jobs.active++;
+  }
+  if (jobs.queue == 0 && jobs.active == 0) {
+    jobs.queue = jobs.done;
+    jobs.done = 0;
+  }
+}
+
+Element Summary(const Jobs& jobs) {
+  static const InternedText& kDone = Intern(L"- done:   ");
+  static const InternedText& kActive = Intern(L"- active: ");
+  static const InternedText& kQueue = Intern(L"- queue:  ");
+  static const InternedText& kTitle = Intern(L" Summary ");
+
+  auto content = vbox({
+      hbox({label(kDone), text(std::to_string(jobs.done)) | bold}) |
+          color(Color::Green),
+      hbox({label(kActive), text(std::to_string(jobs.active)) | bold}) |
+          color(Color::RedLight),
+      hbox({label(kQueue), text(std::to_string(jobs.queue)) | bold}) |
+          color(Color::Red),
+  });
+  return window(label(kTitle), content);
+}
+
+Element Dashboard(const Jobs& jobs) {
+  auto summary = [&] { return Summary(jobs); };
+
+  auto document =  //
+      vbox({
+          hbox({
+              summary(),
+              summary(),
+              summary() | flex,
+          }),
+          summary(),
+          summary(),
+      });
+
+  // Limit the size of the document to 80 char.
+  document = document | size(WIDTH, LESS_THAN, 80);
+  return document;
+}
+
+// The first panel starts at the top left corner, its counters inside the
+// border, after the labels.
+static_assert(StaticLayout<DashboardLayout>::Place(80)[0].x_min == 11);
+static_assert(StaticLayout<DashboardLayout>::Place(80)[0].y_min == 1);
+
+Screen& RenderDashboard(StaticLayout<DashboardLayout>& dashboard,
+                        const Jobs& jobs) {
+  char buffers[3][16];
+  std::string_view counts[3];
+  int values[3] = {jobs.done, jobs.active, jobs.queue};
+  for (int i = 0; i < 3; ++i) {
+    char* end = std::to_chars(buffers[i], buffers[i] + 16, values[i]).ptr;
+    counts[i] = std::string_view(buffers[i], end - buffers[i]);
+  }
+
+  StaticLayout<DashboardLayout>::Values fields;
+  for (size_t i = 0; i < fields.size(); ++i)
+    fields[i] = counts[i % 3];
+  return dashboard.Render(fields);
+}
+
+}  // namespace app
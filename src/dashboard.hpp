@@ -0,0 +1,63 @@
+#ifndef FTXUI_STARTER_DASHBOARD_HPP
+#define FTXUI_STARTER_DASHBOARD_HPP
+
+#include "ftxui/dom/elements.hpp"
+#include "static_layout.hpp"
+
+namespace app {
+
+// Job counters displayed by the summary panels.
+struct Jobs {
+  int done = 3;
+  int active = 2;
+  int queue = 9;
+};
+
+// Moves one job along the queue -> active -> done pipeline, so that a live
+// dashboard changes over time.
+void Advance(Jobs& jobs);
+
+// One summary panel: the counters, in a window.
+ftxui::Element Summary(const Jobs& jobs);
+
+// The dashboard: five summary panels, limited to 80 columns.
+ftxui::Element Dashboard(const Jobs& jobs);
+
+namespace dashboard_layout {
+
+inline constexpr char kTitle[] = " Summary ";
+inline constexpr char kDone[] = "- done:   ";
+inline constexpr char kActive[] = "- active: ";
+inline constexpr char kQueue[] = "- queue:  ";
+
+// Counters are given room for 4 digits.
+using Count = layout::Bold<layout::Field<4>>;
+
+using Summary = layout::Window<
+    layout::Label<kTitle>,
+    layout::VBox<
+        layout::Colored<ftxui::Color::Green,
+                        layout::HBox<layout::Label<kDone>, Count>>,
+        layout::Colored<ftxui::Color::RedLight,
+                        layout::HBox<layout::Label<kActive>, Count>>,
+        layout::Colored<ftxui::Color::Red,
+                        layout::HBox<layout::Label<kQueue>, Count>>>>;
+
+}  // namespace dashboard_layout
+
+// Same structure as Dashboard(), with the layout resolved at compile time.
+using DashboardLayout = layout::MaxWidth<
+    80,
+    layout::VBox<layout::HBox<dashboard_layout::Summary,
+                              dashboard_layout::Summary,
+                              layout::Flex<dashboard_layout::Summary>>,
+                 dashboard_layout::Summary,
+                 dashboard_layout::Summary>>;
+
+// Writes |jobs| into the fields of a static dashboard.
+ftxui::Screen& RenderDashboard(StaticLayout<DashboardLayout>& dashboard,
+                               const Jobs& jobs);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_DASHBOARD_HPP
@@ -0,0 +1,144 @@
+#ifndef FTXUI_STARTER_DATA_SOURCE_HPP
+#define FTXUI_STARTER_DATA_SOURCE_HPP
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <utility>
+
+#include "event_loop.hpp"
+
+namespace app {
+
+// A coroutine producing values of T over time, on an EventLoop. The coroutine
+// co_yields every new value, and co_awaits Sleep() or Readable() instead of
+// blocking, so that slow sources never delay rendering.
+//
+// Usage:
+//   Source<int> Count(EventLoop& loop) {
+//     for (int i = 0;; ++i) {
+//       co_await Sleep(loop, std::chrono::seconds(1));
+//       co_yield i;
+//     }
+//   }
+//
+//   Source<int> count = Count(loop);
+//   count.Start([&](const int& value) { RedrawCounter(value); });
+//   loop.Run();
+template <class T>
+class Source {
+ public:
+  using Callback = std::function<void(const T&)>;
+
+  struct promise_type {
+    Source get_return_object() {
+      return Source(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    std::suspend_never yield_value(const T& value) {
+      if (on_update)
+        on_update(value);
+      return {};
+    }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+
+    Callback on_update;
+  };
+
+  Source() = default;
+  Source(Source&& other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+  Source& operator=(Source&& other) noexcept {
+    std::swap(handle_, other.handle_);
+    return *this;
+  }
+  Source(const Source&) = delete;
+  Source& operator=(const Source&) = delete;
+  // Stops the coroutine where it is suspended.
+  ~Source() {
+    if (handle_)
+      handle_.destroy();
+  }
+
+  // Runs the coroutine until it first suspends. From then on, |on_update| is
+  // called with every value it yields. |on_update| must not destroy the
+  // Source.
+  void Start(Callback on_update) {
+    handle_.promise().on_update = std::move(on_update);
+    handle_.resume();
+  }
+
+  // Whether the coroutine returned.
+  bool done() const { return !handle_ || handle_.done(); }
+
+ private:
+  explicit Source(std::coroutine_handle<promise_type> handle)
+      : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+// Suspends a coroutine for |delay|.
+class Sleep {
+ public:
+  Sleep(EventLoop& loop, std::chrono::milliseconds delay)
+      : loop_(loop), delay_(delay) {}
+  Sleep(const Sleep&) = delete;
+  Sleep& operator=(const Sleep&) = delete;
+  ~Sleep() {
+    if (timer_ >= 0)
+      loop_.RemoveTimer(timer_);
+  }
+
+  bool await_ready() const { return delay_.count() <= 0; }
+  bool await_suspend(std::coroutine_handle<> handle) {
+    timer_ = loop_.AddTimeout(delay_, [this, handle] {
+      timer_ = -1;
+      handle.resume();
+    });
+    // Resume at once if the timer cannot be created.
+    return timer_ >= 0;
+  }
+  void await_resume() const {}
+
+ private:
+  EventLoop& loop_;
+  std::chrono::milliseconds delay_;
+  int timer_ = -1;
+};
+
+// Suspends a coroutine until |fd| is readable.
+class Readable {
+ public:
+  Readable(EventLoop& loop, int fd) : loop_(loop), fd_(fd) {}
+  Readable(const Readable&) = delete;
+  Readable& operator=(const Readable&) = delete;
+  ~Readable() {
+    if (watching_)
+      loop_.Unwatch(fd_);
+  }
+
+  bool await_ready() const { return false; }
+  bool await_suspend(std::coroutine_handle<> handle) {
+    watching_ = loop_.Watch(fd_, [this, handle] {
+      loop_.Unwatch(fd_);
+      watching_ = false;
+      handle.resume();
+    });
+    // Resume at once, and let the read fail, if |fd| cannot be watched.
+    return watching_;
+  }
+  void await_resume() const {}
+
+ private:
+  EventLoop& loop_;
+  int fd_;
+  bool watching_ = false;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_DATA_SOURCE_HPP
@@ -0,0 +1,163 @@
+#include "event_loop.hpp"
+
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+
+namespace app {
+
+namespace {
+
+constexpr int kMaxEvents = 64;
+
+timespec ToTimespec(std::chrono::milliseconds duration) {
+  timespec time;
+  time.tv_sec = duration.count() / 1000;
+  time.tv_nsec = (duration.count() % 1000) * 1000000;
+  return time;
+}
+
+}  // namespace
+
+EventLoop::EventLoop() : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)) {
+  sigemptyset(&signals_);
+}
+
+EventLoop::~EventLoop() {
+  if (signal_fd_ >= 0) {
+    close(signal_fd_);
+    sigprocmask(SIG_UNBLOCK, &signals_, nullptr);
+  }
+  if (epoll_fd_ >= 0)
+    close(epoll_fd_);
+}
+
+bool EventLoop::Watch(int fd, Callback callback) {
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  int operation = watches_.count(fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+  if (epoll_ctl(epoll_fd_, operation, fd, &event) < 0)
+    return false;
+  watches_[fd] = std::make_shared<Callback>(std::move(callback));
+  return true;
+}
+
+void EventLoop::Unwatch(int fd) {
+  if (watches_.erase(fd))
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+int EventLoop::AddTimer(std::chrono::milliseconds interval, Callback callback) {
+  return CreateTimer(interval, interval, std::move(callback));
+}
+
+int EventLoop::AddTimeout(std::chrono::milliseconds delay, Callback callback) {
+  return CreateTimer(delay, std::chrono::milliseconds(0), std::move(callback));
+}
+
+int EventLoop::CreateTimer(std::chrono::milliseconds delay,
+                           std::chrono::milliseconds interval,
+                           Callback callback) {
+  int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (timer < 0)
+    return -1;
+
+  itimerspec spec = {};
+  spec.it_interval = ToTimespec(interval);
+  // A zero value would disarm the timer.
+  spec.it_value = ToTimespec(std::max(delay, std::chrono::milliseconds(1)));
+  bool repeat = interval.count() > 0;
+  auto on_expired = [this, timer, repeat, callback = std::move(callback)] {
+    // Expirations missed while busy are delivered as one call.
+    uint64_t expirations;
+    if (read(timer, &expirations, sizeof(expirations)) <= 0)
+      return;
+    if (!repeat)
+      RemoveTimer(timer);
+    callback();
+  };
+  if (timerfd_settime(timer, 0, &spec, nullptr) < 0 ||
+      !Watch(timer, std::move(on_expired))) {
+    int error = errno;
+    close(timer);
+    errno = error;
+    return -1;
+  }
+  return timer;
+}
+
+void EventLoop::RemoveTimer(int timer) {
+  if (!watches_.count(timer))
+    return;
+  Unwatch(timer);
+  close(timer);
+}
+
+bool EventLoop::OnSignal(int signal, Callback callback) {
+  sigset_t signals = signals_;
+  sigaddset(&signals, signal);
+  if (sigprocmask(SIG_BLOCK, &signals, nullptr) < 0)
+    return false;
+
+  int fd = signalfd(signal_fd_, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+  if (fd < 0)
+    return false;
+
+  if (signal_fd_ < 0) {
+    signal_fd_ = fd;
+    if (!Watch(signal_fd_, [this] { DispatchSignals(); }))
+      return false;
+  }
+  signals_ = signals;
+  signal_handlers_[signal] = std::make_shared<Callback>(std::move(callback));
+  return true;
+}
+
+void EventLoop::Defer(Callback callback) {
+  deferred_.push_back(std::move(callback));
+}
+
+void EventLoop::Run() {
+  quit_ = false;
+  while (!quit_)
+    RunOnce(-1);
+}
+
+void EventLoop::RunOnce(int timeout_ms) {
+  if (!deferred_.empty())
+    timeout_ms = 0;
+  epoll_event events[kMaxEvents];
+  int count = epoll_wait(epoll_fd_, events, kMaxEvents, timeout_ms);
+  for (int i = 0; i < count; ++i) {
+    auto it = watches_.find(events[i].data.fd);
+    if (it == watches_.end())
+      continue;
+    std::shared_ptr<Callback> callback = it->second;
+    (*callback)();
+  }
+
+  // Deferred callbacks may defer more work, for the next wakeup.
+  std::vector<Callback> deferred;
+  deferred.swap(deferred_);
+  for (Callback& callback : deferred)
+    callback();
+}
+
+void EventLoop::DispatchSignals() {
+  signalfd_siginfo info;
+  while (read(signal_fd_, &info, sizeof(info)) == sizeof(info)) {
+    auto it = signal_handlers_.find(info.ssi_signo);
+    if (it == signal_handlers_.end())
+      continue;
+    std::shared_ptr<Callback> callback = it->second;
+    (*callback)();
+  }
+}
+
+}  // namespace app
@@ -0,0 +1,85 @@
+#ifndef FTXUI_STARTER_EVENT_LOOP_HPP
+#define FTXUI_STARTER_EVENT_LOOP_HPP
+
+#include <signal.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace app {
+
+// Waits, with epoll, for file descriptors to become readable, for timers to
+// expire and for signals, and calls the matching callbacks. Timers are
+// timerfds and signals are received through a signalfd, so a loop with nothing
+// to do sleeps in the kernel.
+//
+// Usage:
+//   EventLoop loop;
+//   loop.Watch(STDIN_FILENO, [&] { ReadInput(); });
+//   loop.AddTimer(std::chrono::seconds(1), [&] { Refresh(); });
+//   loop.OnSignal(SIGWINCH, [&] { Resize(); });
+//   loop.OnSignal(SIGINT, [&] { loop.Quit(); });
+//   loop.Run();
+class EventLoop {
+ public:
+  using Callback = std::function<void()>;
+
+  EventLoop();
+  ~EventLoop();
+  EventLoop(const EventLoop&) = delete;
+  EventLoop& operator=(const EventLoop&) = delete;
+
+  // Calls |callback| whenever |fd| is readable, until Unwatch(fd). Returns
+  // false and sets errno on failure.
+  bool Watch(int fd, Callback callback);
+  void Unwatch(int fd);
+
+  // Calls |callback| every |interval|. Returns an identifier for
+  // RemoveTimer(), or -1 and sets errno on failure.
+  int AddTimer(std::chrono::milliseconds interval, Callback callback);
+  void RemoveTimer(int timer);
+
+  // Calls |callback| once, after |delay|. Returns an identifier for
+  // RemoveTimer(), or -1 and sets errno on failure.
+  int AddTimeout(std::chrono::milliseconds delay, Callback callback);
+
+  // Calls |callback| once, after the events of the current wakeup are
+  // dispatched. Each call defers its own callback: merging the work of
+  // several events, such as one redraw for many changes, is up to the caller.
+  void Defer(Callback callback);
+
+  // Calls |callback| when the process receives |signal|, instead of the
+  // signal's handler. The signal is blocked for the whole process, so this
+  // must be called before starting threads.
+  bool OnSignal(int signal, Callback callback);
+
+  // Dispatches events until Quit() is called.
+  void Run();
+  void Quit() { quit_ = true; }
+
+  // Dispatches the events available within |timeout_ms| milliseconds, or
+  // indefinitely when negative.
+  void RunOnce(int timeout_ms);
+
+ private:
+  int CreateTimer(std::chrono::milliseconds delay,
+                  std::chrono::milliseconds interval,
+                  Callback callback);
+  void DispatchSignals();
+
+  int epoll_fd_ = -1;
+  int signal_fd_ = -1;
+  sigset_t signals_;
+  bool quit_ = false;
+  // Shared, so that a callback removing itself does not destroy itself.
+  std::unordered_map<int, std::shared_ptr<Callback>> watches_;
+  std::unordered_map<int, std::shared_ptr<Callback>> signal_handlers_;
+  std::vector<Callback> deferred_;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_EVENT_LOOP_HPP
@@ -0,0 +1,264 @@
+#include "fanout_server.hpp"
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+
+#include "listen_socket.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+constexpr int kMaxEvents = 64;
+
+}  // namespace
+
+FanoutServer::FanoutServer() : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)) {}
+
+FanoutServer::~FanoutServer() {
+  for (auto& it : clients_)
+    close(it.first);
+  for (int fd : listeners_)
+    close(fd);
+  for (const std::string& path : unix_paths_)
+    unlink(path.c_str());
+  if (epoll_fd_ >= 0)
+    close(epoll_fd_);
+}
+
+bool FanoutServer::Listen(const std::string& address) {
+  std::string unix_path;
+  int fd = ListenSocket(address, &unix_path);
+  if (fd < 0)
+    return false;
+  if (!AddListener(fd)) {
+    int error = errno;
+    close(fd);
+    if (!unix_path.empty())
+      unlink(unix_path.c_str());
+    errno = error;
+    return false;
+  }
+  if (!unix_path.empty())
+    unix_paths_.push_back(unix_path);
+  return true;
+}
+
+bool FanoutServer::AddListener(int fd) {
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0)
+    return false;
+  listeners_.push_back(fd);
+  return true;
+}
+
+void FanoutServer::Publish(LayoutCache& layouts) {
+  ++frame_;
+  std::vector<int> closed;
+  for (auto& it : clients_) {
+    Client& client = it.second;
+    int width = client.width > 0 ? client.width : default_width_;
+    Terminal::Color colors =
+        client.has_colors ? client.colors : default_colors_;
+
+    // Moving to another channel means starting over from a full redraw.
+    int key = layouts.Bucket(width) * 4 + colors;
+    if (key != client.channel) {
+      client.channel = key;
+      client.stale = true;
+    }
+
+    // The first client of a channel renders and encodes its frame.
+    Channel& channel = channels_.try_emplace(key, colors).first->second;
+    if (channel.frame != frame_) {
+      channel.frame = frame_;
+      std::string diff = channel.encoder.Diff(layouts.Get(width));
+      if (diff.empty()) {
+        channel.diff.reset();
+      } else {
+        channel.diff = std::make_shared<const std::string>(std::move(diff));
+        channel.full_frame.reset();
+      }
+    }
+
+    // Still writing an older frame: skip this one, and catch up with a full
+    // redraw once the socket drains.
+    if (client.frame) {
+      if (channel.diff) {
+        client.stale = true;
+        ++coalesced_frames_;
+      }
+      continue;
+    }
+
+    if (!client.stale) {
+      if (!channel.diff)
+        continue;
+      client.frame = channel.diff;
+    }
+    if (!Flush(client))
+      closed.push_back(it.first);
+  }
+
+  for (int fd : closed)
+    Close(fd);
+
+  // Drop the channels nobody watches anymore.
+  for (auto it = channels_.begin(); it != channels_.end();) {
+    if (it->second.frame != frame_)
+      it = channels_.erase(it);
+    else
+      ++it;
+  }
+}
+
+void FanoutServer::Dispatch(int timeout_ms) {
+  epoll_event events[kMaxEvents];
+  int count = epoll_wait(epoll_fd_, events, kMaxEvents, timeout_ms);
+  for (int i = 0; i < count; ++i) {
+    int fd = events[i].data.fd;
+    uint32_t flags = events[i].events;
+
+    bool is_listener = false;
+    for (int listener : listeners_)
+      is_listener |= listener == fd;
+    if (is_listener) {
+      Accept(fd);
+      continue;
+    }
+
+    auto it = clients_.find(fd);
+    if (it == clients_.end())
+      continue;
+
+    if (flags & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
+      Close(fd);
+      continue;
+    }
+
+    if ((flags & EPOLLIN) && !Receive(it->second)) {
+      Close(fd);
+      continue;
+    }
+
+    if ((flags & EPOLLOUT) && !Flush(it->second))
+      Close(fd);
+  }
+}
+
+void FanoutServer::Accept(int listener) {
+  for (;;) {
+    int fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0)
+      return;
+
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+      close(fd);
+      continue;
+    }
+
+    Client& client = clients_[fd];
+    client.fd = fd;
+    if (!Flush(client))
+      Close(fd);
+  }
+}
+
+// Reads the lines sent by the client. Returns false when the client is gone.
+bool FanoutServer::Receive(Client& client) {
+  char buffer[256];
+  ssize_t n;
+  while ((n = recv(client.fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+    client.input.append(buffer, n);
+
+    size_t end;
+    while ((end = client.input.find('\n')) != std::string::npos) {
+      std::string line = client.input.substr(0, end);
+      client.input.erase(0, end + 1);
+
+      int width = 0;
+      char colors[16];
+      if (std::sscanf(line.c_str(), "width %d", &width) == 1 && width > 0) {
+        client.width = width;
+      } else if (std::sscanf(line.c_str(), "colors %15s", colors) == 1) {
+        client.has_colors = ParseColorSupport(colors, &client.colors);
+      }
+    }
+
+    // Whatever else clients type is of no interest.
+    if (client.input.size() > sizeof(buffer))
+      client.input.clear();
+  }
+  return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
+// Writes as much of the client's pending output as the socket accepts.
+// Returns false when the client is gone.
+bool FanoutServer::Flush(Client& client) {
+  for (;;) {
+    if (!client.frame) {
+      if (!client.stale)
+        break;
+      // A client that has not been published to yet has no channel.
+      auto it = channels_.find(client.channel);
+      if (it == channels_.end())
+        break;
+      Channel& channel = it->second;
+      if (!channel.full_frame) {
+        channel.full_frame =
+            std::make_shared<const std::string>(channel.encoder.Full());
+      }
+      client.frame = channel.full_frame;
+      client.sent = 0;
+      client.stale = false;
+    }
+
+    const std::string& frame = *client.frame;
+    while (client.sent < frame.size()) {
+      ssize_t n = send(client.fd, frame.data() + client.sent,
+                       frame.size() - client.sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+      if (n < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+          return false;
+        WatchOutput(client, true);
+        return true;
+      }
+      client.sent += n;
+    }
+
+    client.frame.reset();
+    client.sent = 0;
+  }
+
+  WatchOutput(client, false);
+  return true;
+}
+
+void FanoutServer::WatchOutput(Client& client, bool enable) {
+  if (client.watching_output == enable)
+    return;
+  epoll_event event = {};
+  event.events = EPOLLIN | EPOLLRDHUP | (enable ? uint32_t{EPOLLOUT} : 0u);
+  event.data.fd = client.fd;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, client.fd, &event);
+  client.watching_output = enable;
+}
+
+void FanoutServer::Close(int fd) {
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  close(fd);
+  clients_.erase(fd);
+}
+
+}  // namespace app
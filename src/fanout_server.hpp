@@ -0,0 +1,130 @@
+#ifndef FTXUI_STARTER_FANOUT_SERVER_HPP
+#define FTXUI_STARTER_FANOUT_SERVER_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "frame_encoder.hpp"
+#include "layout_cache.hpp"
+
+namespace app {
+
+// Serves one document to many terminal clients connected over Unix or TCP
+// sockets. Clients are grouped by the width bucket of their terminal: each
+// frame is rendered and encoded once per bucket, as a diff against the
+// previous frame of that bucket, and the same buffer is shared by every
+// client of the bucket.
+//
+// A client reports its terminal width by sending a "width <columns>" line,
+// and the colors it supports with a "colors <2|16|256|truecolor>" line, at
+// any time. Until then it is assumed to be default_width() columns wide and
+// to support default_colors(). Clients of the same width bucket but with
+// different color supports get separately encoded frames.
+//
+// Clients are never waited for: a client that is still receiving an older
+// frame when a new one is published skips the frames in between and gets a
+// single full redraw of the latest frame once its socket drains.
+//
+// Usage:
+//   FanoutServer server;
+//   server.Listen("unix:/tmp/dashboard.sock");
+//   server.Listen("tcp:7000");
+//   LayoutCache layouts(20, 80);
+//   for (;;) {
+//     layouts.SetDocument(document);
+//     server.Publish(layouts);
+//     server.Dispatch(timeout_ms);
+//   }
+class FanoutServer {
+ public:
+  FanoutServer();
+  ~FanoutServer();
+  FanoutServer(const FanoutServer&) = delete;
+  FanoutServer& operator=(const FanoutServer&) = delete;
+
+  // Starts accepting clients on |address|, either "unix:<path>" or
+  // "tcp:[<host>:]<port>". Can be called several times. Returns false and
+  // sets errno on failure.
+  bool Listen(const std::string& address);
+
+  // Renders the current document of |layouts| for every width bucket in use,
+  // and queues the result for the clients of each bucket.
+  void Publish(LayoutCache& layouts);
+
+  // Accepts new clients and writes pending frames, waiting at most
+  // |timeout_ms| milliseconds for socket activity.
+  void Dispatch(int timeout_ms);
+
+  // The epoll file descriptor. It becomes readable whenever Dispatch() has
+  // work to do, so it can be nested in another event loop.
+  int fd() const { return epoll_fd_; }
+
+  size_t client_count() const { return clients_.size(); }
+
+  // Width of the clients that did not report theirs.
+  int default_width() const { return default_width_; }
+  void set_default_width(int width) { default_width_ = width; }
+
+  // Color support of the clients that did not report theirs.
+  ftxui::Terminal::Color default_colors() const { return default_colors_; }
+  void set_default_colors(ftxui::Terminal::Color colors) {
+    default_colors_ = colors;
+  }
+
+  // Number of frames that were skipped for slow clients.
+  size_t coalesced_frames() const { return coalesced_frames_; }
+
+ private:
+  // The frames of one width bucket, for one color support.
+  struct Channel {
+    explicit Channel(ftxui::Terminal::Color colors) : encoder(colors) {}
+
+    FrameEncoder encoder;
+    // Diff produced by the latest Publish(), null when nothing changed.
+    std::shared_ptr<const std::string> diff;
+    // Full redraw of the latest frame, encoded lazily when a client needs it.
+    std::shared_ptr<const std::string> full_frame;
+    int frame = -1;
+  };
+
+  struct Client {
+    int fd = -1;
+    int width = 0;
+    ftxui::Terminal::Color colors = ftxui::Terminal::TrueColor;
+    bool has_colors = false;
+    // Key of the channel the client receives, -1 until the first frame.
+    int channel = -1;
+    // Bytes received since the last complete line.
+    std::string input;
+    // The frame being written, and how many bytes of it were sent.
+    std::shared_ptr<const std::string> frame;
+    size_t sent = 0;
+    // The client missed at least one frame and needs a full redraw.
+    bool stale = true;
+    bool watching_output = false;
+  };
+
+  bool AddListener(int fd);
+  void Accept(int listener);
+  bool Receive(Client& client);
+  bool Flush(Client& client);
+  void WatchOutput(Client& client, bool enable);
+  void Close(int fd);
+
+  int epoll_fd_ = -1;
+  std::vector<int> listeners_;
+  std::vector<std::string> unix_paths_;
+  std::unordered_map<int, Client> clients_;
+  std::unordered_map<int, Channel> channels_;
+
+  int default_width_ = 80;
+  ftxui::Terminal::Color default_colors_ = ftxui::Terminal::TrueColor;
+  int frame_ = 0;
+  size_t coalesced_frames_ = 0;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_FANOUT_SERVER_HPP
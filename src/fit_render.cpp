@@ -0,0 +1,55 @@
+#include "fit_render.hpp"
+
+#include <algorithm>
+
+#include "ftxui/dom/node.hpp"
+#include "ftxui/screen/box.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+// As in Render(): layouts like flexbox ask for more passes, up to this many.
+constexpr int kMaxIterations = 20;
+
+}  // namespace
+
+Dimensions Measure(const Element& document, Dimensions limit) {
+  document->ComputeRequirement();
+  Requirement requirement = document->requirement();
+  return {std::min(requirement.min_x, limit.dimx),
+          std::min(requirement.min_y, limit.dimy)};
+}
+
+Dimensions Measure(const Element& document) {
+  return Measure(document, Dimension::Full());
+}
+
+void RenderMeasured(Screen& screen, const Element& document) {
+  Box box;
+  box.x_min = 0;
+  box.y_min = 0;
+  box.x_max = screen.dimx() - 1;
+  box.y_max = screen.dimy() - 1;
+
+  // The first pass of Render(), but for the requirements, already known.
+  document->SetBox(box);
+  Node::Status status;
+  status.iteration = 1;
+  document->Check(&status);
+  while (status.need_iteration && status.iteration < kMaxIterations) {
+    document->ComputeRequirement();
+    document->SetBox(box);
+    status.need_iteration = false;
+    status.iteration++;
+    document->Check(&status);
+  }
+
+  screen.stencil = box;
+  document->Render(screen);
+  screen.ApplyShader();
+}
+
+}  // namespace app
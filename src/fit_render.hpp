@@ -0,0 +1,32 @@
+#ifndef FTXUI_STARTER_FIT_RENDER_HPP
+#define FTXUI_STARTER_FIT_RENDER_HPP
+
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/screen.hpp"
+
+namespace app {
+
+// Sizing a Screen to its document with Dimension::Fit() computes the
+// requirements of the whole tree, and Render() computes them again before
+// laying it out. These two functions split Render() so that the requirements
+// are computed once:
+//
+//   Dimensions size = Measure(document, {80, 1000});
+//   Screen& screen = screens.Get(size.dimx, size.dimy);
+//   RenderMeasured(screen, document);
+
+// The size |document| asks for, at most |limit|, as Dimension::Fit() gives
+// it. The requirements of the tree are left computed for RenderMeasured().
+ftxui::Dimensions Measure(const ftxui::Element& document,
+                          ftxui::Dimensions limit);
+// Same, at most the size of the terminal, as Dimension::Fit().
+ftxui::Dimensions Measure(const ftxui::Element& document);
+
+// Lays |document| out in |screen| and renders it, as Render() does, starting
+// from the requirements computed by Measure(). |document| must not have
+// changed since.
+void RenderMeasured(ftxui::Screen& screen, const ftxui::Element& document);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_FIT_RENDER_HPP
@@ -0,0 +1,126 @@
+#include "flex_layout.hpp"
+
+#include <algorithm>
+
+#include "ftxui/dom/node.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+void FlexLayout::Resize(size_t count) {
+  if (items_.size() == count)
+    return;
+  items_.resize(count);
+  sizes_.resize(count);
+  dirty_ = true;
+}
+
+void FlexLayout::Update(size_t i, const Item& item) {
+  if (items_[i] == item)
+    return;
+  items_[i] = item;
+  dirty_ = true;
+}
+
+// Distributes the space as FTXUI's box_helper::Compute() does: the extra space
+// goes to the children that grow, in proportion; missing space is taken from
+// the children that shrink, in proportion to their size, then from all.
+const std::vector<int>& FlexLayout::Solve(int width) {
+  if (!dirty_ && width == width_)
+    return sizes_;
+  dirty_ = false;
+  width_ = width;
+  solves_++;
+
+  int size = 0;
+  int grow_sum = 0;
+  int shrink_sum = 0;
+  int shrink_size = 0;
+  for (const Item& item : items_) {
+    grow_sum += item.grow;
+    shrink_sum += item.min * item.shrink;
+    if (item.shrink)
+      shrink_size += item.min;
+    size += item.min;
+  }
+
+  int extra = width - size;
+  if (extra >= 0) {
+    for (size_t i = 0; i < items_.size(); ++i) {
+      int added = extra * items_[i].grow / std::max(grow_sum, 1);
+      extra -= added;
+      grow_sum -= items_[i].grow;
+      sizes_[i] = items_[i].min + added;
+    }
+  } else if (shrink_size + extra >= 0) {
+    for (size_t i = 0; i < items_.size(); ++i) {
+      int weight = items_[i].min * items_[i].shrink;
+      int added = extra * weight / std::max(shrink_sum, 1);
+      extra -= added;
+      shrink_sum -= weight;
+      sizes_[i] = items_[i].min + added;
+    }
+  } else {
+    // The children that shrink disappear, the others share what is missing.
+    extra += shrink_size;
+    size -= shrink_size;
+    for (size_t i = 0; i < items_.size(); ++i) {
+      if (items_[i].shrink) {
+        sizes_[i] = 0;
+        continue;
+      }
+      int added = extra * items_[i].min / std::max(size, 1);
+      extra -= added;
+      size -= items_[i].min;
+      sizes_[i] = items_[i].min + added;
+    }
+  }
+  return sizes_;
+}
+
+class FlexHBoxNode : public Node {
+ public:
+  FlexHBoxNode(Elements children, FlexLayout* layout)
+      : Node(std::move(children)), layout_(layout) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = 0;
+    requirement_.min_y = 0;
+    requirement_.flex_grow_x = 0;
+    requirement_.flex_grow_y = 0;
+    requirement_.flex_shrink_x = 0;
+    requirement_.flex_shrink_y = 0;
+
+    layout_->Resize(children_.size());
+    for (size_t i = 0; i < children_.size(); ++i) {
+      children_[i]->ComputeRequirement();
+      const Requirement& child = children_[i]->requirement();
+      layout_->Update(i, {child.min_x, child.flex_grow_x, child.flex_shrink_x});
+      requirement_.min_x += child.min_x;
+      requirement_.min_y = std::max(requirement_.min_y, child.min_y);
+    }
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    const std::vector<int>& sizes = layout_->Solve(box.x_max - box.x_min + 1);
+    int x = box.x_min;
+    for (size_t i = 0; i < children_.size(); ++i) {
+      Box child = box;
+      child.x_min = x;
+      child.x_max = x + sizes[i] - 1;
+      children_[i]->SetBox(child);
+      x = child.x_max + 1;
+    }
+  }
+
+ private:
+  FlexLayout* layout_;
+};
+
+Element flex_hbox(Elements children, FlexLayout* layout) {
+  return std::make_shared<FlexHBoxNode>(std::move(children), layout);
+}
+
+}  // namespace app
@@ -0,0 +1,50 @@
+#ifndef FTXUI_STARTER_FLEX_LAYOUT_HPP
+#define FTXUI_STARTER_FLEX_LAYOUT_HPP
+
+#include <vector>
+
+#include "ftxui/dom/elements.hpp"
+
+namespace app {
+
+// What a flex_hbox() remembers from one frame to the next: the requirement of
+// every child, and the widths they were given. The space is only distributed
+// again when a requirement or the width of the box changes; otherwise the
+// widths of the last frame are reused.
+class FlexLayout {
+ public:
+  // Number of times the space was distributed.
+  int solves() const { return solves_; }
+
+ private:
+  friend class FlexHBoxNode;
+
+  struct Item {
+    int min = 0;
+    int grow = 0;
+    int shrink = 0;
+    bool operator==(const Item&) const = default;
+  };
+
+  // Sets the requirement of child |i|.
+  void Update(size_t i, const Item& item);
+  // Resizes to |count| children.
+  void Resize(size_t count);
+  // Returns the width of every child in a |width| wide box.
+  const std::vector<int>& Solve(int width);
+
+  std::vector<Item> items_;
+  std::vector<int> sizes_;
+  int width_ = -1;
+  bool dirty_ = true;
+  int solves_ = 0;
+};
+
+// Same as ftxui::hbox(), with the distribution of the space between the
+// children cached in |layout|, which must outlive the element. Focus and
+// selection are not forwarded, so it cannot be scrolled by a frame.
+ftxui::Element flex_hbox(ftxui::Elements children, FlexLayout* layout);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_FLEX_LAYOUT_HPP
@@ -0,0 +1,92 @@
+#include "frame_encoder.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+bool SameStyle(const Pixel& a, const Pixel& b) {
+  return a.bold == b.bold && a.dim == b.dim && a.underlined == b.underlined &&
+         a.blink == b.blink && a.inverted == b.inverted &&
+         a.foreground_color == b.foreground_color &&
+         a.background_color == b.background_color;
+}
+
+bool SamePixel(const Pixel& a, const Pixel& b) {
+  return a.character == b.character && SameStyle(a, b);
+}
+
+}  // namespace
+
+FrameEncoder::FrameEncoder(Terminal::Color colors) : colors_(colors) {}
+
+void FrameEncoder::AppendStyle(std::string& out, const Pixel& pixel) {
+  out += "\x1B[0";
+  if (pixel.bold)
+    out += ";1";
+  if (pixel.dim)
+    out += ";2";
+  if (pixel.underlined)
+    out += ";4";
+  if (pixel.blink)
+    out += ";5";
+  if (pixel.inverted)
+    out += ";7";
+  out += ';';
+  colors_.Append(out, pixel.foreground_color, false);
+  out += ';';
+  colors_.Append(out, pixel.background_color, true);
+  out += 'm';
+}
+
+std::string FrameEncoder::Diff(Screen& screen) {
+  bool resized = screen.dimx() != dimx_ || screen.dimy() != dimy_;
+  if (resized) {
+    dimx_ = screen.dimx();
+    dimy_ = screen.dimy();
+    rows_.assign(dimy_, std::vector<Pixel>(dimx_));
+  }
+
+  std::string out;
+  for (int y = 0; y < dimy_; ++y) {
+    bool changed = false;
+    std::vector<Pixel>& row = rows_[y];
+    for (int x = 0; x < dimx_; ++x) {
+      const Pixel& pixel = screen.PixelAt(x, y);
+      if (!SamePixel(row[x], pixel)) {
+        row[x] = pixel;
+        changed = true;
+      }
+    }
+    if (changed && !resized)
+      AppendRow(out, y);
+  }
+
+  return resized ? Full() : out;
+}
+
+std::string FrameEncoder::Full() {
+  std::string out = "\x1B[H\x1B[2J";
+  for (int y = 0; y < dimy_; ++y)
+    AppendRow(out, y);
+  return out;
+}
+
+void FrameEncoder::AppendRow(std::string& out, int y) {
+  // Move to the start of the row: ESC [ row ; column H, 1-based.
+  out += "\x1B[";
+  out += std::to_string(y + 1);
+  out += ";1H";
+
+  const Pixel* previous = nullptr;
+  for (const Pixel& pixel : rows_[y]) {
+    if (!previous || !SameStyle(*previous, pixel))
+      AppendStyle(out, pixel);
+    out += pixel.character;
+    previous = &pixel;
+  }
+  out += "\x1B[0m";
+}
+
+}  // namespace app
@@ -0,0 +1,46 @@
+#ifndef FTXUI_STARTER_FRAME_ENCODER_HPP
+#define FTXUI_STARTER_FRAME_ENCODER_HPP
+
+#include <string>
+#include <vector>
+
+#include "color_quantizer.hpp"
+#include "ftxui/screen/screen.hpp"
+
+namespace app {
+
+// Serializes Screens into ANSI escape sequences. The encoder remembers the
+// last frame it saw, so that consecutive frames can be sent as the list of
+// rows that changed instead of the whole Screen. Colors are downsampled to
+// what the receiving terminal supports.
+class FrameEncoder {
+ public:
+  explicit FrameEncoder(
+      ftxui::Terminal::Color colors = ftxui::Terminal::TrueColor);
+
+  // Records |screen| as the current frame and returns the escape sequences
+  // turning the previous frame into it. Returns a full redraw when there was
+  // no previous frame or when the dimensions changed, and an empty string
+  // when nothing changed.
+  std::string Diff(ftxui::Screen& screen);
+
+  // Returns a full redraw of the current frame: clears the terminal and draws
+  // every row.
+  std::string Full();
+
+  int dimx() const { return dimx_; }
+  int dimy() const { return dimy_; }
+
+ private:
+  void AppendRow(std::string& out, int y);
+  void AppendStyle(std::string& out, const ftxui::Pixel& pixel);
+
+  ColorQuantizer colors_;
+  int dimx_ = 0;
+  int dimy_ = 0;
+  std::vector<std::vector<ftxui::Pixel>> rows_;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_FRAME_ENCODER_HPP
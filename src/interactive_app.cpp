@@ -0,0 +1,328 @@
+#include "interactive_app.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "color_quantizer.hpp"
+#include "dashboard.hpp"
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/screen.hpp"
+#include "ftxui/screen/terminal.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+// Jobs changing state every second.
+constexpr int kChangesPerTick = 64;
+
+// Height of the log panels, borders included.
+constexpr int kLogHeight = 12;
+
+std::string Describe(JobOrder order, std::optional<JobState> filter) {
+  std::string description =
+      order == JobOrder::Id ? "by id" : "by queue time";
+  description += filter ? std::string(", ") + ToString(*filter) + " only"
+                        : std::string(", all jobs");
+  return description;
+}
+
+}  // namespace
+
+InteractiveApp::InteractiveApp(JobList jobs,
+                               const std::vector<std::string>& log_paths)
+    : encoder_(DetectColorSupport()), jobs_(std::move(jobs)) {
+  for (const std::string& path : log_paths) {
+    logs_.Add(path);
+    searches_.push_back(std::make_unique<LogSearch>());
+  }
+}
+
+int InteractiveApp::Run() {
+  if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) {
+    std::cerr << "The interactive mode needs a terminal for its input and "
+                 "output"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  loop_.Watch(STDIN_FILENO, [this] { ReadInput(); });
+  loop_.AddTimer(std::chrono::seconds(1), [this] {
+    Simulate();
+    ScheduleDraw();
+  });
+  loop_.Watch(logs_.fd(), [this] {
+    if (logs_.Dispatch())
+      ScheduleDraw();
+  });
+  for (auto& search : searches_) {
+    loop_.Watch(search->fd(), [this, search = search.get()] {
+      if (search->Collect())
+        ScheduleDraw();
+    });
+  }
+  loop_.AddTimer(std::chrono::milliseconds(100), [this] {
+    system_.Sample();
+    ScheduleDraw();
+  });
+  loop_.OnSignal(SIGWINCH, [this] {
+    // The frame is laid out at the size of the terminal when it is drawn.
+    events_received_++;
+    ScheduleDraw();
+  });
+  loop_.OnSignal(SIGINT, [this] { loop_.Quit(); });
+  loop_.OnSignal(SIGTERM, [this] { loop_.Quit(); });
+  if (!latency_path_.empty()) {
+    loop_.AddTimer(kLatencyPeriod,
+                   [this] { latency_.WriteFile(latency_path_); });
+  }
+
+  system_.Sample();
+  {
+    TerminalMode terminal;
+    Draw();
+    loop_.Run();
+  }
+  if (!latency_path_.empty())
+    latency_.WriteFile(latency_path_);
+  return EXIT_SUCCESS;
+}
+
+void InteractiveApp::ReadInput() {
+  char buffer[4096];
+  ssize_t size = read(STDIN_FILENO, buffer, sizeof(buffer));
+  if (size <= 0) {
+    loop_.Quit();
+    return;
+  }
+
+  // What follows an escape character completes it.
+  if (escape_timeout_ >= 0) {
+    loop_.RemoveTimer(escape_timeout_);
+    escape_timeout_ = -1;
+  }
+  events_.clear();
+  parser_.Feed(std::string_view(buffer, size), events_);
+  if (parser_.escape_pending()) {
+    escape_timeout_ = loop_.AddTimeout(InputParser::kEscapeTimeout, [this] {
+      escape_timeout_ = -1;
+      events_.clear();
+      parser_.FlushEscape(events_);
+      HandleEvents();
+    });
+  }
+  HandleEvents();
+}
+
+void InteractiveApp::HandleEvents() {
+  events_received_ += events_.size();
+  for (const Event& event : events_)
+    OnEvent(event);
+  // A pasted pattern is searched for once.
+  if (pattern_changed_) {
+    pattern_changed_ = false;
+    Search();
+  }
+  ScheduleDraw();
+}
+
+void InteractiveApp::OnEvent(const Event& event) {
+  if (editing_pattern_) {
+    OnSearchEvent(event);
+    return;
+  }
+
+  long page = std::max(1, table_.visible_rows());
+  if (event == Event::ArrowUp) {
+    scroll_by_ -= 1;
+  } else if (event == Event::ArrowDown) {
+    scroll_by_ += 1;
+  } else if (event == Event::PageUp) {
+    scroll_by_ -= page;
+  } else if (event == Event::PageDown) {
+    scroll_by_ += page;
+  } else if (event == Event::Home) {
+    scroll_to_ = 0;
+    scroll_by_ = 0;
+  } else if (event == Event::End) {
+    // Clamped to the last page by the table.
+    scroll_to_ = jobs_.size();
+    scroll_by_ = 0;
+  } else if (event == Event::Character('s')) {
+    order_ = order_ == JobOrder::Id ? JobOrder::QueueTime : JobOrder::Id;
+    scroll_to_ = 0;
+    scroll_by_ = 0;
+  } else if (event == Event::Character('f')) {
+    // All -> done -> active -> queued -> all.
+    if (!filter_)
+      filter_ = JobState::Done;
+    else if (*filter_ == JobState::Queued)
+      filter_.reset();
+    else
+      filter_ = static_cast<JobState>(static_cast<int>(*filter_) + 1);
+    scroll_to_ = 0;
+    scroll_by_ = 0;
+  } else if (event == Event::Character('/') && logs_.size()) {
+    editing_pattern_ = true;
+  } else if (event == Event::Escape && !pattern_.empty()) {
+    pattern_.clear();
+    pattern_changed_ = true;
+  } else if (event == Event::Character('q') || event == Event::Escape) {
+    loop_.Quit();
+  }
+}
+
+void InteractiveApp::OnSearchEvent(const Event& event) {
+  if (event == Event::Return) {
+    editing_pattern_ = false;
+    return;
+  }
+  if (event == Event::Escape) {
+    editing_pattern_ = false;
+    pattern_.clear();
+  } else if (event == Event::Backspace) {
+    // Removes the last UTF-8 sequence.
+    while (!pattern_.empty() && (pattern_.back() & 0xC0) == 0x80)
+      pattern_.pop_back();
+    if (!pattern_.empty())
+      pattern_.pop_back();
+  } else if (event.is_character()) {
+    pattern_ += event.character();
+  } else {
+    return;
+  }
+  pattern_changed_ = true;
+}
+
+void InteractiveApp::Search() {
+  pattern_valid_ = true;
+  for (size_t i = 0; i < searches_.size(); ++i) {
+    if (pattern_.empty())
+      searches_[i]->Stop();
+    else if (!searches_[i]->Start(logs_[i].path(), pattern_))
+      pattern_valid_ = false;
+  }
+}
+
+void InteractiveApp::Simulate() {
+  if (jobs_.size() == 0)
+    return;
+  for (int i = 0; i < kChangesPerTick; ++i) {
+    random_ ^= random_ << 13;
+    random_ ^= random_ >> 17;
+    random_ ^= random_ << 5;
+    size_t row = random_ % jobs_.size();
+    switch (jobs_[row].state) {
+      case JobState::Queued:
+        jobs_.SetState(row, JobState::Active);
+        break;
+      case JobState::Active:
+        jobs_.SetState(row, JobState::Done);
+        break;
+      case JobState::Done:
+        jobs_.SetState(row, JobState::Queued);
+        break;
+    }
+  }
+}
+
+void InteractiveApp::ScheduleDraw() {
+  if (draw_scheduled_)
+    return;
+  draw_scheduled_ = true;
+
+  auto elapsed = std::chrono::steady_clock::now() - last_frame_;
+  if (elapsed >= kFramePeriod) {
+    // Still after the other events of this wakeup.
+    loop_.Defer([this] { Draw(); });
+  } else {
+    auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+        kFramePeriod - elapsed);
+    loop_.AddTimeout(delay, [this] { Draw(); });
+  }
+}
+
+void InteractiveApp::Draw() {
+  draw_scheduled_ = false;
+  last_frame_ = std::chrono::steady_clock::now();
+  frames_rendered_++;
+
+  if (scroll_to_) {
+    // Offsets following a jump to the end count from the last page.
+    size_t rows =
+        filter_ ? jobs_.Sorted(order_, filter_).size() : jobs_.size();
+    size_t visible = std::max(0, table_.visible_rows());
+    table_.ScrollTo(std::min(*scroll_to_, rows - std::min(rows, visible)));
+  }
+  table_.ScrollBy(scroll_by_);
+  scroll_to_.reset();
+  scroll_by_ = 0;
+
+  Jobs counts;
+  counts.done = static_cast<int>(jobs_.Count(JobState::Done));
+  counts.active = static_cast<int>(jobs_.Count(JobState::Active));
+  counts.queue = static_cast<int>(jobs_.Count(JobState::Queued));
+
+  auto document = vbox({
+      flex_hbox(
+          {
+              Summary(counts),
+              SystemPanels(system_),
+              vbox({
+                  text(" " + Describe(order_, filter_)),
+                  text(" arrows, page up/down, home/end: scroll") | dim,
+                  text(" s: sort, f: filter, /: search logs, q: quit") | dim,
+                  text(" " + std::to_string(events_received_) + " events, " +
+                       std::to_string(frames_rendered_) + " frames") |
+                      dim,
+              }) | flex,
+          },
+          &header_),
+      JobTable(jobs_, &table_, order_, filter_) | flex,
+  });
+  if (logs_.size()) {
+    Elements tails;
+    for (size_t i = 0; i < logs_.size(); ++i) {
+      LogSearch& search = *searches_[i];
+      if (!search.active()) {
+        tails.push_back(window(text(" " + logs_[i].path() + " "),
+                               log_tail(logs_[i])) |
+                        flex);
+        continue;
+      }
+      std::string title = " " + logs_[i].path() + ": " +
+                          std::to_string(search.size()) + " matches";
+      if (search.running())
+        title += ", " + std::to_string(int(search.progress() * 100)) + "%";
+      tails.push_back(window(text(title + " "), log_matches(search)) | flex);
+    }
+    document = vbox({document | flex,
+                     hbox(std::move(tails)) | size(HEIGHT, EQUAL, kLogHeight)});
+    if (editing_pattern_ || !pattern_.empty()) {
+      document = vbox({
+          document | flex,
+          hbox({
+              text(" /" + pattern_),
+              text(editing_pattern_ ? " " : "") | inverted,
+              text(pattern_valid_ ? "" : "  invalid pattern") | dim,
+          }),
+      });
+    }
+  }
+
+  Dimensions size = Terminal::Size();
+  Screen& screen = screens_.Get(size.dimx, size.dimy);
+  Render(screen, document);
+  WriteAll(STDOUT_FILENO, encoder_.Diff(screen));
+  latency_.Record(std::chrono::steady_clock::now() - last_frame_);
+}
+
+}  // namespace app
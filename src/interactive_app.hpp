@@ -0,0 +1,118 @@
+#ifndef FTXUI_STARTER_INTERACTIVE_APP_HPP
+#define FTXUI_STARTER_INTERACTIVE_APP_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "event_loop.hpp"
+#include "flex_layout.hpp"
+#include "frame_encoder.hpp"
+#include "ftxui/component/event.hpp"
+#include "job_list.hpp"
+#include "latency_histogram.hpp"
+#include "log_search.hpp"
+#include "log_tail.hpp"
+#include "screen_pool.hpp"
+#include "system_panels.hpp"
+#include "terminal_input.hpp"
+#include "virtual_table.hpp"
+
+namespace app {
+
+// The dashboard and the system panels above a scrollable table of jobs, and
+// optionally the tails of log files, in the terminal. Everything happens on an
+// EventLoop: the process sleeps until a key is pressed, the terminal is
+// resized, or the jobs change.
+//
+// Input is coalesced: frames are drawn at most every kFramePeriod, and what
+// happened in between is merged, so that holding a key or dragging the edge
+// of the terminal costs one layout per frame rather than one per event.
+// Scrolling adds up into one offset, and resizes into one layout at the final
+// size.
+//
+// Keys: arrows, page up/down, home/end scroll; 's' toggles the order; 'f'
+// cycles the state filter; '/' searches the logs as the pattern is typed,
+// until return; escape clears the search, or quits like 'q'.
+class InteractiveApp {
+ public:
+  // Follows the log files at |log_paths| below the table.
+  explicit InteractiveApp(JobList jobs,
+                          const std::vector<std::string>& log_paths = {});
+
+  // Writes the latency of the frames to |path| every kLatencyPeriod, and
+  // when quitting. See FrameLatencyMonitor.
+  void ExportLatency(std::string path) { latency_path_ = std::move(path); }
+
+  // Runs until the user quits. Returns the exit code.
+  int Run();
+
+  static constexpr std::chrono::milliseconds kFramePeriod{16};
+  static constexpr std::chrono::seconds kLatencyPeriod{10};
+
+  // Input events and resizes received, and frames drawn for them.
+  uint64_t events_received() const { return events_received_; }
+  uint64_t frames_rendered() const { return frames_rendered_; }
+
+ private:
+  void ReadInput();
+  // Handles the events parsed into |events_|.
+  void HandleEvents();
+  void OnEvent(const ftxui::Event& event);
+  void OnSearchEvent(const ftxui::Event& event);
+  // Searches the logs for |pattern_|, stopping the previous searches.
+  void Search();
+  // Moves some jobs along the queued -> active -> done pipeline.
+  void Simulate();
+  // Draws a frame as soon as kFramePeriod has passed since the last one.
+  void ScheduleDraw();
+  void Draw();
+
+  EventLoop loop_;
+  InputParser parser_;
+  // Timeout taking a lone escape character for the Escape key, or -1.
+  int escape_timeout_ = -1;
+  FrameEncoder encoder_;
+  ScreenPool screens_;
+  std::vector<ftxui::Event> events_;
+
+  SystemMonitor system_;
+  // The panels above the table keep their widths while the terminal does.
+  FlexLayout header_;
+  LogFollower logs_;
+  // One search per log file.
+  std::vector<std::unique_ptr<LogSearch>> searches_;
+  std::string pattern_;
+  bool editing_pattern_ = false;
+  bool pattern_changed_ = false;
+  bool pattern_valid_ = true;
+  JobList jobs_;
+  TableState table_;
+  JobOrder order_ = JobOrder::Id;
+  std::optional<JobState> filter_;
+  uint32_t random_ = 1;
+
+  // Scrolling received since the last frame: an absolute position, then an
+  // offset from it.
+  std::optional<size_t> scroll_to_;
+  long scroll_by_ = 0;
+  bool draw_scheduled_ = false;
+  std::chrono::steady_clock::time_point last_frame_;
+
+  uint64_t events_received_ = 0;
+  uint64_t frames_rendered_ = 0;
+  // From the start of Draw() to the end of the write, against kFramePeriod.
+  FrameLatencyMonitor latency_{
+      "ftxui_starter_frame",
+      "Time from the start of building a frame to the end of writing it.",
+      kFramePeriod};
+  std::string latency_path_;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_INTERACTIVE_APP_HPP
@@ -0,0 +1,81 @@
+#include "interned_text.hpp"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "ftxui/dom/node.hpp"
+#include "ftxui/screen/string.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+class Label : public Node {
+ public:
+  explicit Label(const InternedText& text) : text_(text) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = text_.width;
+    requirement_.min_y = 1;
+  }
+
+  void Render(Screen& screen) override {
+    int x = box_.x_min;
+    const int y = box_.y_min;
+    if (y > box_.y_max)
+      return;
+    for (const std::string& cell : text_.cells) {
+      if (x > box_.x_max)
+        return;
+      screen.PixelAt(x, y).character = cell;
+      ++x;
+    }
+  }
+
+ private:
+  const InternedText& text_;
+};
+
+struct Pool {
+  std::mutex mutex;
+  std::unordered_map<std::string_view, std::unique_ptr<InternedText>> texts;
+};
+
+Pool& GetPool() {
+  // Never destroyed: interned texts must outlive every Element.
+  static Pool* pool = new Pool;
+  return *pool;
+}
+
+}  // namespace
+
+const InternedText& Intern(std::string_view text) {
+  Pool& pool = GetPool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+
+  auto it = pool.texts.find(text);
+  if (it != pool.texts.end())
+    return *it->second;
+
+  auto interned = std::make_unique<InternedText>();
+  interned->utf8 = std::string(text);
+  interned->cells = Utf8ToGlyphs(interned->utf8);
+  interned->width = string_width(interned->utf8);
+
+  // The key views the string owned by the value, which never moves.
+  std::string_view key = interned->utf8;
+  return *pool.texts.emplace(key, std::move(interned)).first->second;
+}
+
+const InternedText& Intern(std::wstring_view text) {
+  return Intern(to_string(std::wstring(text)));
+}
+
+Element label(const InternedText& text) {
+  return std::make_shared<Label>(text);
+}
+
+}  // namespace app
@@ -0,0 +1,35 @@
+#ifndef FTXUI_STARTER_INTERNED_TEXT_HPP
+#define FTXUI_STARTER_INTERNED_TEXT_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ftxui/dom/elements.hpp"
+
+namespace app {
+
+// A string stored once for the whole program, split into the characters of
+// its cells ahead of time.
+struct InternedText {
+  std::string utf8;
+  // One entry per cell. The second cell of a full width character is empty.
+  std::vector<std::string> cells;
+  int width = 0;
+};
+
+// Returns the unique InternedText equal to |text|. The result lives until the
+// end of the program. Thread safe.
+const InternedText& Intern(std::string_view text);
+const InternedText& Intern(std::wstring_view text);
+
+// Like ftxui::text(), for a string interned beforehand. Labels repeated in
+// every frame or every panel share one copy of their text and skip decoding
+// it:
+//   static const InternedText& kTitle = Intern(" Summary ");
+//   window(label(kTitle), content);
+ftxui::Element label(const InternedText& text);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_INTERNED_TEXT_HPP
@@ -0,0 +1,180 @@
+#include "job_list.hpp"
+
+#include <charconv>
+#include <ctime>
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+int64_t SortValue(const Job& job, JobOrder order) {
+  return order == JobOrder::Id ? static_cast<int64_t>(job.id) : job.queued_at;
+}
+
+}  // namespace
+
+JobList::JobList() = default;
+JobList::~JobList() = default;
+JobList::JobList(JobList&&) = default;
+JobList& JobList::operator=(JobList&&) = default;
+
+JobList JobList::Synthetic(size_t count, uint32_t seed) {
+  static const char* const kNames[] = {
+      "build", "test", "package", "deploy", "lint", "backup", "index",
+  };
+  const int64_t kStart = 1700000000;
+
+  JobList list;
+  list.jobs_.reserve(count);
+  uint32_t random = seed * 2654435761u + 1;
+  for (size_t i = 0; i < count; ++i) {
+    // xorshift32: cheap and reproducible.
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+
+    Job job;
+    job.id = i + 1;
+    job.state = static_cast<JobState>(random % 3);
+    job.queued_at = kStart + static_cast<int64_t>(i) * 3 + (random >> 8) % 60;
+    job.name = kNames[(random >> 4) % 7];
+    job.name += '-';
+    job.name += std::to_string(random % 1000);
+    list.Add(std::move(job));
+  }
+  return list;
+}
+
+void JobList::Add(Job job) {
+  jobs_.push_back(std::move(job));
+  Insert(jobs_.size() - 1);
+}
+
+void JobList::SetState(size_t row, JobState state) {
+  Erase(row);
+  jobs_[row].state = state;
+  Insert(row);
+}
+
+void JobList::SetQueuedAt(size_t row, int64_t queued_at) {
+  Erase(row);
+  jobs_[row].queued_at = queued_at;
+  Insert(row);
+}
+
+const JobIndex& JobList::Sorted(JobOrder order,
+                                std::optional<JobState> filter) const {
+  std::unique_ptr<View>& view = views_[static_cast<int>(order)];
+  if (!view) {
+    view = std::make_unique<View>();
+    for (size_t row = 0; row < jobs_.size(); ++row) {
+      const Job& job = jobs_[row];
+      JobKey key = {SortValue(job, order), row};
+      view->all.Insert(key);
+      view->by_state[static_cast<int>(job.state)].Insert(key);
+    }
+  }
+  return filter ? view->by_state[static_cast<int>(*filter)] : view->all;
+}
+
+void JobList::Insert(size_t row) {
+  const Job& job = jobs_[row];
+  counts_[static_cast<int>(job.state)]++;
+  for (int order = 0; order < 2; ++order) {
+    if (View* view = views_[order].get()) {
+      JobKey key = {SortValue(job, static_cast<JobOrder>(order)), row};
+      view->all.Insert(key);
+      view->by_state[static_cast<int>(job.state)].Insert(key);
+    }
+  }
+}
+
+void JobList::Erase(size_t row) {
+  const Job& job = jobs_[row];
+  counts_[static_cast<int>(job.state)]--;
+  for (int order = 0; order < 2; ++order) {
+    if (View* view = views_[order].get()) {
+      JobKey key = {SortValue(job, static_cast<JobOrder>(order)), row};
+      view->all.Erase(key);
+      view->by_state[static_cast<int>(job.state)].Erase(key);
+    }
+  }
+}
+
+const char* ToString(JobState state) {
+  switch (state) {
+    case JobState::Done:
+      return "done";
+    case JobState::Active:
+      return "active";
+    case JobState::Queued:
+      return "queue";
+  }
+  return "";
+}
+
+std::vector<TableColumn> JobColumns() {
+  return {
+      {"id", 2, 12, true},
+      {"state", 6, 6, false},
+      {"queued", 8, 8, false},
+      {"name", 4, 40, false},
+  };
+}
+
+void FormatJob(const Job& job, std::vector<std::string>& cells) {
+  char buffer[24];
+  char* end = std::to_chars(buffer, buffer + sizeof(buffer), job.id).ptr;
+  cells[0].assign(buffer, end);
+
+  cells[1] = ToString(job.state);
+
+  std::time_t time = job.queued_at;
+  std::tm tm;
+  gmtime_r(&time, &tm);
+  cells[2].resize(sizeof(buffer));
+  cells[2].resize(std::strftime(&cells[2][0], sizeof(buffer), "%H:%M:%S", &tm));
+
+  cells[3] = job.name;
+}
+
+TableRows JobRows(const JobList& jobs,
+                  JobOrder order,
+                  std::optional<JobState> filter) {
+  TableRows rows;
+  if (order == JobOrder::Id && !filter) {
+    rows.count = jobs.size();
+    rows.format = [&jobs](size_t row, std::vector<std::string>& cells) {
+      FormatJob(jobs[row], cells);
+    };
+    return rows;
+  }
+
+  const JobIndex& index = jobs.Sorted(order, filter);
+  rows.count = index.size();
+  // Tables read their visible rows one after the other: keep a cursor on the
+  // last one, and only seek when reading elsewhere.
+  auto cursor = std::make_shared<JobIndex::Cursor>(index.Seek(index.size()));
+  rows.format = [&jobs, &index, cursor](size_t row,
+                                        std::vector<std::string>& cells) {
+    if (!*cursor || cursor->position() != row) {
+      if (*cursor && cursor->position() + 1 == row)
+        ++*cursor;
+      else
+        *cursor = index.Seek(row);
+    }
+    FormatJob(jobs[(*cursor)->row], cells);
+  };
+  return rows;
+}
+
+Element JobTable(const JobList& jobs,
+                 TableState* state,
+                 JobOrder order,
+                 std::optional<JobState> filter) {
+  return virtual_table(JobColumns(), JobRows(jobs, order, filter), state);
+}
+
+}  // namespace app
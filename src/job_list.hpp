@@ -0,0 +1,112 @@
+#ifndef FTXUI_STARTER_JOB_LIST_HPP
+#define FTXUI_STARTER_JOB_LIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ftxui/dom/elements.hpp"
+#include "ordered_index.hpp"
+#include "virtual_table.hpp"
+
+namespace app {
+
+enum class JobState : uint8_t { Done, Active, Queued };
+
+struct Job {
+  uint64_t id = 0;
+  JobState state = JobState::Queued;
+  // Seconds since the epoch.
+  int64_t queued_at = 0;
+  std::string name;
+};
+
+enum class JobOrder : uint8_t { Id, QueueTime };
+
+// Position of a job in a sorted view: the value sorted on, then the row of the
+// job in its JobList.
+struct JobKey {
+  int64_t value;
+  size_t row;
+
+  bool operator<(const JobKey& other) const {
+    return value != other.value ? value < other.value : row < other.row;
+  }
+};
+
+using JobIndex = OrderedIndex<JobKey>;
+
+// The jobs counted by the summary panels.
+//
+// Besides storage order, the list provides views sorted by id or by queue
+// time, optionally restricted to one state. A view is built the first time it
+// is asked for, in O(n log n), and then kept up to date by every change, in
+// O(log n), so that a table can show any window of it without sorting.
+class JobList {
+ public:
+  JobList();
+  ~JobList();
+  JobList(JobList&&);
+  JobList& operator=(JobList&&);
+
+  // Generates |count| jobs with reproducible names, states and times.
+  static JobList Synthetic(size_t count, uint32_t seed = 0);
+
+  size_t size() const { return jobs_.size(); }
+  const Job& operator[](size_t row) const { return jobs_[row]; }
+
+  // Number of jobs in |state|.
+  size_t Count(JobState state) const {
+    return counts_[static_cast<int>(state)];
+  }
+
+  void Add(Job job);
+  void SetState(size_t row, JobState state);
+  void SetQueuedAt(size_t row, int64_t queued_at);
+
+  // The rows of the jobs matching |filter|, in |order|.
+  const JobIndex& Sorted(JobOrder order,
+                         std::optional<JobState> filter = std::nullopt) const;
+
+ private:
+  // The views sorted in one order: all the jobs, then one per state.
+  struct View {
+    JobIndex all;
+    JobIndex by_state[3];
+  };
+
+  void Insert(size_t row);
+  void Erase(size_t row);
+
+  std::vector<Job> jobs_;
+  size_t counts_[3] = {};
+  // Indexed by JobOrder. Null until first asked for.
+  mutable std::unique_ptr<View> views_[2];
+};
+
+const char* ToString(JobState state);
+
+// Columns of the job table: id, state, queue time and name.
+std::vector<TableColumn> JobColumns();
+
+// Writes the cells of |job| in the order of JobColumns().
+void FormatJob(const Job& job, std::vector<std::string>& cells);
+
+// Rows of a table listing the jobs of |jobs| matching |filter|, in |order|.
+// Consecutive rows are read from the view in O(1) each.
+TableRows JobRows(const JobList& jobs,
+                  JobOrder order = JobOrder::Id,
+                  std::optional<JobState> filter = std::nullopt);
+
+// A table listing the jobs of |jobs| matching |filter|, in |order|.
+ftxui::Element JobTable(const JobList& jobs,
+                        TableState* state,
+                        JobOrder order = JobOrder::Id,
+                        std::optional<JobState> filter = std::nullopt);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_JOB_LIST_HPP
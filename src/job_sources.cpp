@@ -0,0 +1,60 @@
+#include "job_sources.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+#include <string>
+
+namespace app {
+
+Source<Jobs> MockJobs(EventLoop& loop,
+                      std::chrono::milliseconds period,
+                      Jobs jobs) {
+  for (;;) {
+    co_yield jobs;
+    co_await Sleep(loop, period);
+    Advance(jobs);
+  }
+}
+
+Source<Jobs> ReadJobs(EventLoop& loop, int fd) {
+  std::string input;
+  char buffer[4096];
+  for (;;) {
+    co_await Readable(loop, fd);
+    ssize_t size = read(fd, buffer, sizeof(buffer));
+    if (size < 0 && (errno == EINTR || errno == EAGAIN))
+      continue;
+    if (size <= 0)
+      co_return;
+
+    input.append(buffer, size);
+    size_t start = 0;
+    for (size_t end; (end = input.find('\n', start)) != std::string::npos;
+         start = end + 1) {
+      Jobs jobs;
+      if (ParseJobs(std::string_view(input).substr(start, end - start), jobs))
+        co_yield jobs;
+    }
+    input.erase(0, start);
+  }
+}
+
+bool ParseJobs(std::string_view line, Jobs& jobs) {
+  const char* it = line.data();
+  const char* end = line.data() + line.size();
+  for (int* value : {&jobs.done, &jobs.active, &jobs.queue}) {
+    while (it != end && *it == ' ')
+      ++it;
+    auto result = std::from_chars(it, end, *value);
+    if (result.ec != std::errc())
+      return false;
+    it = result.ptr;
+  }
+  while (it != end && (*it == ' ' || *it == '\r'))
+    ++it;
+  return it == end;
+}
+
+}  // namespace app
@@ -0,0 +1,30 @@
+#ifndef FTXUI_STARTER_JOB_SOURCES_HPP
+#define FTXUI_STARTER_JOB_SOURCES_HPP
+
+#include <chrono>
+#include <string_view>
+
+#include "dashboard.hpp"
+#include "data_source.hpp"
+#include "event_loop.hpp"
+
+namespace app {
+
+// Yields |jobs| moved along by Advance() every |period|. Stands in for a real
+// source in tests and demos.
+Source<Jobs> MockJobs(EventLoop& loop,
+                      std::chrono::milliseconds period,
+                      Jobs jobs = Jobs());
+
+// Yields the counters read from |fd|, a pipe, socket or file, one
+// "<done> <active> <queue>" line at a time. Malformed lines are skipped.
+// Returns at the end of the input.
+Source<Jobs> ReadJobs(EventLoop& loop, int fd);
+
+// Parses a "<done> <active> <queue>" line into |jobs|. Returns false, leaving
+// |jobs| unspecified, if |line| is malformed.
+bool ParseJobs(std::string_view line, Jobs& jobs);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_JOB_SOURCES_HPP
@@ -0,0 +1,132 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+namespace app {
+
+namespace {
+
+int BitLength(uint64_t value) {
+  int length = 0;
+  while (value) {
+    value >>= 1;
+    ++length;
+  }
+  return length;
+}
+
+void AppendSeconds(std::string& out, std::chrono::microseconds duration) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.6f", duration.count() / 1e6);
+  out += buffer;
+}
+
+}  // namespace
+
+// Values below kSubCount have a bucket each. Above, the values with the same
+// bit length share kHalf buckets, indexed by their top kSubBits bits.
+size_t LatencyHistogram::Index(uint64_t value) {
+  if (value < kSubCount)
+    return value;
+  int shift = BitLength(value) - kSubBits;
+  return (shift + 1) * kHalf + ((value >> shift) - kHalf);
+}
+
+uint64_t LatencyHistogram::Highest(size_t index) {
+  if (index < kSubCount)
+    return index;
+  int shift = static_cast<int>(index / kHalf) - 1;
+  uint64_t top = index % kHalf + kHalf;
+  return ((top + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(std::chrono::microseconds duration) {
+  uint64_t value = std::max<int64_t>(0, duration.count());
+  value = std::min(value, (uint64_t(1) << kMaxBits) - 1);
+  counts_[Index(value)]++;
+  count_++;
+  sum_ += value;
+  max_ = std::max(max_, value);
+}
+
+std::chrono::microseconds LatencyHistogram::Percentile(double quantile) const {
+  if (count_ == 0)
+    return std::chrono::microseconds(0);
+  uint64_t rank = static_cast<uint64_t>(std::ceil(quantile * count_));
+  rank = std::clamp<uint64_t>(rank, 1, count_);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    seen += counts_[i];
+    if (seen >= rank)
+      return std::chrono::microseconds(std::min(Highest(i), max_));
+  }
+  return std::chrono::microseconds(max_);
+}
+
+void LatencyHistogram::Clear() {
+  counts_.fill(0);
+  count_ = sum_ = max_ = 0;
+}
+
+FrameLatencyMonitor::FrameLatencyMonitor(std::string prefix,
+                                         std::string help,
+                                         std::chrono::microseconds budget)
+    : prefix_(std::move(prefix)), help_(std::move(help)), budget_(budget) {}
+
+void FrameLatencyMonitor::Record(std::chrono::steady_clock::duration latency) {
+  auto microseconds =
+      std::chrono::duration_cast<std::chrono::microseconds>(latency);
+  histogram_.Record(microseconds);
+  if (microseconds > budget_)
+    over_budget_++;
+}
+
+std::string FrameLatencyMonitor::Format() const {
+  std::string out;
+  std::string latency = prefix_ + "_latency_seconds";
+  out += "# HELP " + latency + ' ' + help_ + '\n';
+  out += "# TYPE " + latency + " summary\n";
+  for (const char* quantile : {"0.5", "0.99", "0.999"}) {
+    out += latency + "{quantile=\"" + quantile + "\"} ";
+    AppendSeconds(out, histogram_.Percentile(std::atof(quantile)));
+    out += '\n';
+  }
+  out += latency + "_sum ";
+  AppendSeconds(out, histogram_.sum());
+  out += '\n';
+  out += latency + "_count " + std::to_string(histogram_.count()) + '\n';
+
+  std::string over = prefix_ + "_over_budget_total";
+  out += "# HELP " + over + " Frames that took longer than the budget.\n";
+  out += "# TYPE " + over + " counter\n";
+  out += over + ' ' + std::to_string(over_budget_) + '\n';
+
+  std::string budget = prefix_ + "_budget_seconds";
+  out += "# HELP " + budget + " Latency budget of a frame.\n";
+  out += "# TYPE " + budget + " gauge\n";
+  out += budget + ' ';
+  AppendSeconds(out, budget_);
+  out += '\n';
+  return out;
+}
+
+bool FrameLatencyMonitor::WriteFile(const std::string& path) const {
+  // Renamed over |path| once complete.
+  std::string temporary = path + ".tmp";
+  FILE* file = std::fopen(temporary.c_str(), "w");
+  if (!file)
+    return false;
+  std::string text = Format();
+  bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+  written = std::fclose(file) == 0 && written;
+  if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+    std::remove(temporary.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace app
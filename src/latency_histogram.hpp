@@ -0,0 +1,98 @@
+#ifndef FTXUI_STARTER_LATENCY_HISTOGRAM_HPP
+#define FTXUI_STARTER_LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace app {
+
+// Counts durations in log-linear buckets, as HdrHistogram does: every power
+// of two is split into 64 buckets, so that any percentile is known within
+// 1.6%, from 1 microsecond to over an hour, in a fixed array. Recording is an
+// increment.
+class LatencyHistogram {
+ public:
+  void Record(std::chrono::microseconds duration);
+
+  uint64_t count() const { return count_; }
+  std::chrono::microseconds sum() const {
+    return std::chrono::microseconds(sum_);
+  }
+  std::chrono::microseconds max() const {
+    return std::chrono::microseconds(max_);
+  }
+
+  // The duration below which a |quantile| (0 to 1) of the values fall,
+  // rounded up to the end of its bucket. Zero when empty.
+  std::chrono::microseconds Percentile(double quantile) const;
+
+  void Clear();
+
+ private:
+  static constexpr int kSubBits = 7;
+  static constexpr uint64_t kSubCount = 1 << kSubBits;
+  static constexpr uint64_t kHalf = kSubCount / 2;
+  // Values up to 2^kMaxBits microseconds, about 19 hours.
+  static constexpr int kMaxBits = 36;
+  static constexpr size_t kBuckets = (kMaxBits - kSubBits + 2) * kHalf;
+
+  static size_t Index(uint64_t value);
+  // The largest value counted in |index|.
+  static uint64_t Highest(size_t index);
+
+  std::array<uint64_t, kBuckets> counts_ = {};
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t max_ = 0;
+};
+
+// Tracks the time frames take against a budget: their latency histogram, and
+// the number of frames over the budget. The figures are exported in the
+// Prometheus text format, to a file that node_exporter's textfile collector
+// or any scraper can read.
+//
+// Usage:
+//   FrameLatencyMonitor latency("ftxui_starter_frame",
+//                               "Time from the start of building a frame to "
+//                               "the end of writing it.",
+//                               milliseconds(16));
+//   auto start = steady_clock::now();
+//   ... build, lay out, render and write the frame ...
+//   latency.Record(steady_clock::now() - start);
+//   loop.AddTimer(seconds(10), [&] { latency.WriteFile("/run/frame.prom"); });
+class FrameLatencyMonitor {
+ public:
+  // Metrics are named after |prefix|, e.g. "<prefix>_latency_seconds", and
+  // the latency is described by |help|: what the time is measured from and
+  // to.
+  FrameLatencyMonitor(std::string prefix,
+                      std::string help,
+                      std::chrono::microseconds budget);
+
+  void Record(std::chrono::steady_clock::duration latency);
+
+  const LatencyHistogram& histogram() const { return histogram_; }
+  uint64_t over_budget() const { return over_budget_; }
+
+  // The metrics, in the Prometheus text exposition format: the p50, p99 and
+  // p999 latencies and their sum and count as a summary, the frames over
+  // budget as a counter, and the budget as a gauge.
+  std::string Format() const;
+
+  // Replaces the file at |path| with Format(), atomically: a reader never
+  // sees a partial file. Returns false and sets errno on failure.
+  bool WriteFile(const std::string& path) const;
+
+ private:
+  std::string prefix_;
+  std::string help_;
+  std::chrono::microseconds budget_;
+  LatencyHistogram histogram_;
+  uint64_t over_budget_ = 0;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,68 @@
+#include "layout_cache.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "fit_render.hpp"
+#include "screen_pool.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+LayoutCache::LayoutCache(int min_width, int max_width, int step)
+    : min_width_(std::max(1, min_width)),
+      max_width_(std::max(min_width_, max_width)),
+      step_(std::max(1, step)) {}
+
+void LayoutCache::SetDocument(Element document) {
+  document_ = std::move(document);
+  renders_ = 0;
+
+  // Forget the buckets nobody asked for during the last frame.
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.generation < generation_)
+      it = entries_.erase(it);
+    else
+      ++it;
+  }
+  ++generation_;
+}
+
+int LayoutCache::Bucket(int width) const {
+  width = std::min(std::max(width, min_width_), max_width_);
+  return min_width_ + (width - min_width_) / step_ * step_;
+}
+
+std::vector<int> LayoutCache::Buckets() const {
+  std::vector<int> buckets;
+  for (const auto& [bucket, entry] : entries_) {
+    if (entry.generation == generation_)
+      buckets.push_back(bucket);
+  }
+  return buckets;
+}
+
+Screen& LayoutCache::Get(int width) {
+  int bucket = Bucket(width);
+  auto it = entries_.find(bucket);
+  if (it != entries_.end() && it->second.generation == generation_)
+    return it->second.screen;
+
+  // As tall as the document: the clients' terminals are not this process's.
+  int height =
+      Measure(document_, {bucket, std::numeric_limits<int>::max()}).dimy;
+  if (it == entries_.end() || it->second.screen.dimy() != height) {
+    Entry entry = {Screen(bucket, height), generation_};
+    it = entries_.insert_or_assign(bucket, std::move(entry)).first;
+  } else {
+    ClearInPlace(it->second.screen);
+    it->second.generation = generation_;
+  }
+
+  RenderMeasured(it->second.screen, document_);
+  ++renders_;
+  return it->second.screen;
+}
+
+}  // namespace app
@@ -0,0 +1,62 @@
+#ifndef FTXUI_STARTER_LAYOUT_CACHE_HPP
+#define FTXUI_STARTER_LAYOUT_CACHE_HPP
+
+#include <map>
+#include <vector>
+
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/screen.hpp"
+
+namespace app {
+
+// Renders one document at several terminal widths, laying it out once per
+// width bucket instead of once per viewer. Widths are clamped to
+// [min_width, max_width], then rounded down to a multiple of |step| above
+// |min_width|: every width beyond the document's own limit shares a single
+// bucket.
+//
+// Usage:
+//   LayoutCache layouts(20, 80);
+//   layouts.SetDocument(document);
+//   Screen& narrow = layouts.Get(40);
+//   Screen& wide = layouts.Get(132);  // Same Screen as layouts.Get(80).
+class LayoutCache {
+ public:
+  LayoutCache(int min_width, int max_width, int step = 1);
+
+  // Starts a new frame showing |document|. The Screens of the previous frame
+  // are kept, to be reused by the buckets that are still in use.
+  void SetDocument(ftxui::Element document);
+
+  // Returns the width the document is laid out at for a |width| terminal.
+  int Bucket(int width) const;
+
+  // Returns the current document rendered for a |width| terminal. The first
+  // call of a frame for a given bucket renders it, the following calls are
+  // free.
+  ftxui::Screen& Get(int width);
+
+  // The buckets rendered for the current document, in increasing order.
+  std::vector<int> Buckets() const;
+
+  // Number of Screens rendered for the current document.
+  int renders() const { return renders_; }
+
+ private:
+  struct Entry {
+    ftxui::Screen screen;
+    int generation;
+  };
+
+  int min_width_;
+  int max_width_;
+  int step_;
+  ftxui::Element document_;
+  int generation_ = 0;
+  int renders_ = 0;
+  std::map<int, Entry> entries_;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_LAYOUT_CACHE_HPP
@@ -0,0 +1,110 @@
+#include "layout_worker.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace app {
+
+using namespace ftxui;
+
+LayoutWorker::LayoutWorker(int min_width, int max_width, int step)
+    : event_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      front_(std::make_unique<LayoutCache>(min_width, max_width, step)),
+      back_(std::make_unique<LayoutCache>(min_width, max_width, step)) {
+  front_->SetDocument(emptyElement());
+}
+
+LayoutWorker::~LayoutWorker() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    quit_ = true;
+    // Cancels the frame being laid out.
+    latest_++;
+  }
+  wake_.notify_one();
+  if (thread_.joinable())
+    thread_.join();
+  if (event_fd_ >= 0)
+    close(event_fd_);
+}
+
+void LayoutWorker::Request(Builder builder, std::vector<int> widths) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    builder_ = std::move(builder);
+    widths_ = std::move(widths);
+    requested_ = std::chrono::steady_clock::now();
+    latest_++;
+  }
+  wake_.notify_one();
+  if (!thread_.joinable())
+    thread_ = std::thread([this] { Run(); });
+}
+
+bool LayoutWorker::Swap() {
+  uint64_t count;
+  while (read(event_fd_, &count, sizeof(count)) > 0) {
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ready_)
+      return false;
+    std::swap(front_, back_);
+    front_requested_ = back_requested_;
+    ready_ = false;
+  }
+  // The worker may have been waiting for the back buffer.
+  wake_.notify_one();
+  return true;
+}
+
+void LayoutWorker::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    // The back buffer is busy until the frame it holds is shown.
+    wake_.wait(lock, [this] { return quit_ || (builder_ && !ready_); });
+    if (quit_)
+      return;
+    Builder builder = std::move(builder_);
+    builder_ = nullptr;
+    std::vector<int> widths = std::move(widths_);
+    auto requested = requested_;
+    uint64_t request = latest_;
+    lock.unlock();
+
+    bool done = Layout(builder, widths, request);
+
+    lock.lock();
+    if (!done) {
+      cancelled_++;
+      continue;
+    }
+    back_requested_ = requested;
+    ready_ = true;
+    // Only fails when interrupted, or when the counter is about to overflow,
+    // in which case it is readable anyway.
+    uint64_t one = 1;
+    while (write(event_fd_, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+  }
+}
+
+bool LayoutWorker::Layout(const Builder& builder,
+                          const std::vector<int>& widths,
+                          uint64_t request) {
+  Element document = builder();
+  if (latest_ != request)
+    return false;
+  back_->SetDocument(std::move(document));
+  for (int width : widths) {
+    if (latest_ != request)
+      return false;
+    back_->Get(width);
+  }
+  return true;
+}
+
+}  // namespace app
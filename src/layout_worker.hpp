@@ -0,0 +1,100 @@
+#ifndef FTXUI_STARTER_LAYOUT_WORKER_HPP
+#define FTXUI_STARTER_LAYOUT_WORKER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ftxui/dom/elements.hpp"
+#include "layout_cache.hpp"
+
+namespace app {
+
+// Builds and lays out documents on a worker thread, so that a large layout
+// does not hold up the event loop. Frames are double buffered in two
+// LayoutCaches: the front one is shown by the main thread while the back one
+// is filled by the worker, and Swap() exchanges them once a frame is ready.
+// A request made while an older one is still being laid out cancels it.
+//
+// fd() becomes readable when a frame is ready, so that Swap() can be called
+// from an EventLoop.
+//
+// Usage:
+//   LayoutWorker layouts(20, 80);
+//   loop.Watch(layouts.fd(), [&] { layouts.Swap(); });
+//   layouts.Request([jobs] { return Dashboard(jobs); },
+//                   layouts.front().Buckets());
+//   server.Publish(layouts.front());
+class LayoutWorker {
+ public:
+  // Returns a document. Called on the worker thread: it must only use what it
+  // holds by value, or what is not modified elsewhere.
+  using Builder = std::function<ftxui::Element()>;
+
+  // The widths are bucketed as by LayoutCache.
+  LayoutWorker(int min_width, int max_width, int step = 1);
+  ~LayoutWorker();
+  LayoutWorker(const LayoutWorker&) = delete;
+  LayoutWorker& operator=(const LayoutWorker&) = delete;
+
+  // Builds a document with |builder| and renders it at |widths| on the worker
+  // thread. The thread is started by the first request, so that it inherits
+  // the signals blocked by an EventLoop. The time of the request goes along
+  // with the frame, see requested().
+  void Request(Builder builder, std::vector<int> widths);
+
+  int fd() const { return event_fd_; }
+
+  // Shows the latest frame laid out, if a new one is ready. Returns whether
+  // the front frame changed.
+  bool Swap();
+
+  // The frame shown, empty until the first Swap(). Other widths than the
+  // requested ones are rendered on demand, on the calling thread.
+  LayoutCache& front() { return *front_; }
+  // When the front frame was requested, so that its latency can be measured
+  // once it is shown.
+  std::chrono::steady_clock::time_point requested() const {
+    return front_requested_;
+  }
+
+  // Number of requests cancelled by a newer one.
+  uint64_t cancelled() const { return cancelled_; }
+
+ private:
+  void Run();
+  // Returns false if cancelled by a newer request.
+  bool Layout(const Builder& builder,
+              const std::vector<int>& widths,
+              uint64_t request);
+
+  int event_fd_ = -1;
+  std::unique_ptr<LayoutCache> front_;
+  // Only used by the worker, until the frame it holds is ready.
+  std::unique_ptr<LayoutCache> back_;
+  std::chrono::steady_clock::time_point front_requested_;
+  std::chrono::steady_clock::time_point back_requested_;
+  std::thread thread_;
+  // The latest request, checked by the worker as it lays out an older one.
+  std::atomic<uint64_t> latest_ = 0;
+  std::atomic<uint64_t> cancelled_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  // Guarded by |mutex_|.
+  Builder builder_;
+  std::vector<int> widths_;
+  std::chrono::steady_clock::time_point requested_;
+  bool ready_ = false;
+  bool quit_ = false;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_LAYOUT_WORKER_HPP
@@ -0,0 +1,110 @@
+#include "listen_socket.hpp"
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace app {
+
+namespace {
+
+constexpr int kBacklog = 64;
+
+int ListenUnix(const std::string& path) {
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    return -1;
+
+  // Remove the socket left behind by a previous run.
+  unlink(path.c_str());
+  if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      listen(fd, kBacklog) < 0) {
+    int error = errno;
+    close(fd);
+    errno = error;
+    return -1;
+  }
+  return fd;
+}
+
+int ListenTcp(const std::string& host, const std::string& port) {
+  addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE;
+
+  addrinfo* result = nullptr;
+  if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints,
+                  &result) != 0) {
+    errno = EADDRNOTAVAIL;
+    return -1;
+  }
+
+  int error = EADDRNOTAVAIL;
+  int listening = -1;
+  for (addrinfo* info = result; info && listening < 0; info = info->ai_next) {
+    int fd = socket(info->ai_family,
+                    info->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                    info->ai_protocol);
+    if (fd < 0) {
+      error = errno;
+      continue;
+    }
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(fd, info->ai_addr, info->ai_addrlen) < 0 ||
+        listen(fd, kBacklog) < 0) {
+      error = errno;
+      close(fd);
+      continue;
+    }
+    listening = fd;
+  }
+  freeaddrinfo(result);
+
+  if (listening < 0)
+    errno = error;
+  return listening;
+}
+
+}  // namespace
+
+int ListenSocket(const std::string& address, std::string* unix_path) {
+  if (address.rfind("unix:", 0) == 0) {
+    std::string path = address.substr(5);
+    int fd = ListenUnix(path);
+    if (fd >= 0)
+      *unix_path = path;
+    return fd;
+  }
+
+  if (address.rfind("tcp:", 0) == 0) {
+    std::string endpoint = address.substr(4);
+    size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos)
+      return ListenTcp("", endpoint);
+    std::string host = endpoint.substr(0, colon);
+    // Accept bracketed IPv6 literals: tcp:[::1]:7000.
+    if (host.size() >= 2 && host.front() == '[' && host.back() == ']')
+      host = host.substr(1, host.size() - 2);
+    return ListenTcp(host, endpoint.substr(colon + 1));
+  }
+
+  errno = EINVAL;
+  return -1;
+}
+
+}  // namespace app
@@ -0,0 +1,17 @@
+#ifndef FTXUI_STARTER_LISTEN_SOCKET_HPP
+#define FTXUI_STARTER_LISTEN_SOCKET_HPP
+
+#include <string>
+
+namespace app {
+
+// Creates a non-blocking socket listening on |address|, either "unix:<path>"
+// or "tcp:[<host>:]<port>", with bracketed IPv6 hosts as in "tcp:[::1]:7000".
+// Returns it, or -1 and sets errno on failure. The path of a Unix socket is
+// stored in |unix_path|, for the caller to remove once done; it is left
+// untouched for TCP.
+int ListenSocket(const std::string& address, std::string* unix_path);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_LISTEN_SOCKET_HPP
@@ -0,0 +1,376 @@
+#include "log_search.hpp"
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include "ftxui/dom/node.hpp"
+#include "log_tail.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+// Bytes read and searched between two checks for cancellation. Matches found
+// in a window are published at its end.
+constexpr size_t kWindow = 256 << 10;
+// Bytes searched on each side of a candidate for the ends of its line before
+// cutting it. libstdc++'s regex executor recurses for every character, so
+// what is given to std::regex_search must stay far within the stack of a
+// thread: "(a|b)*x" overflows 8 MiB on a line of 16 KiB.
+constexpr size_t kMaxLineScan = 2 << 10;
+// Bytes of a line read for display: what is past them is off the screen.
+constexpr size_t kMaxTextBytes = 1024;
+
+}  // namespace
+
+std::optional<std::string> RequiredLiteral(std::string_view pattern,
+                                           bool* literal) {
+  std::string best;
+  std::string run;
+  int depth = 0;
+  *literal = true;
+  auto end_run = [&] {
+    if (run.size() > best.size())
+      best = run;
+    run.clear();
+  };
+  auto special = [&] {
+    *literal = false;
+    end_run();
+  };
+
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    char c = pattern[i];
+    switch (c) {
+      case '|':
+        // Any of the alternatives may match.
+        *literal = false;
+        return std::nullopt;
+      case '\\':
+        // Escaped punctuation stands for itself, unlike a class like \d or an
+        // assertion like \b.
+        if (depth == 0 && i + 1 < pattern.size() &&
+            std::ispunct(static_cast<unsigned char>(pattern[i + 1]))) {
+          run += pattern[++i];
+          break;
+        }
+        // Anything else ends the run, and none of it is literal text: \xHH,
+        // \uHHHH and \cX are skipped whole, as are the digits of \0 and of
+        // backreferences.
+        special();
+        if (++i < pattern.size()) {
+          char escape = pattern[i];
+          if (escape == 'x')
+            i += 2;
+          else if (escape == 'u')
+            i += 4;
+          else if (escape == 'c')
+            i += 1;
+          while (std::isdigit(static_cast<unsigned char>(escape)) &&
+                 i + 1 < pattern.size() &&
+                 std::isdigit(static_cast<unsigned char>(pattern[i + 1]))) {
+            ++i;
+          }
+        }
+        break;
+      case '[':
+        special();
+        // A ']' right after the '[' or the '^' is part of the set.
+        i += i + 1 < pattern.size() && pattern[i + 1] == '^' ? 2 : 1;
+        if (i < pattern.size() && pattern[i] == ']')
+          ++i;
+        for (; i < pattern.size() && pattern[i] != ']'; ++i) {
+          if (pattern[i] == '\\')
+            ++i;
+        }
+        break;
+      case '(':
+        depth++;
+        special();
+        break;
+      case ')':
+        depth--;
+        special();
+        break;
+      case '*':
+      case '?':
+      case '{':
+        // The character before may not be there.
+        if (!run.empty())
+          run.pop_back();
+        special();
+        if (c == '{')
+          i = std::min(pattern.find('}', i), pattern.size());
+        break;
+      case '+':
+      case '.':
+      case '^':
+      case '$':
+        special();
+        break;
+      default:
+        if (depth == 0)
+          run += c;
+        else
+          special();
+        break;
+    }
+  }
+  end_run();
+  return best;
+}
+
+LogSearch::LogSearch() : event_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+
+LogSearch::~LogSearch() {
+  Stop();
+  if (event_fd_ >= 0)
+    close(event_fd_);
+}
+
+bool LogSearch::Start(const std::string& path, const std::string& pattern) {
+  Stop();
+  if (pattern.empty())
+    return false;
+
+  bool literal = false;
+  std::optional<std::string> required = RequiredLiteral(pattern, &literal);
+  try {
+    if (!literal) {
+      regex_.emplace(pattern,
+                     std::regex::ECMAScript | std::regex::optimize);
+    }
+  } catch (const std::regex_error&) {
+    return false;
+  }
+  literal_ = required.value_or("");
+
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+  struct stat status;
+  if (fstat(fd, &status) < 0) {
+    close(fd);
+    return false;
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  active_ = true;
+  fd_ = fd;
+  size_ = static_cast<size_t>(status.st_size);
+  thread_ = std::thread([this] { Search(); });
+  return true;
+}
+
+void LogSearch::Stop() {
+  cancelled_ = true;
+  if (thread_.joinable())
+    thread_.join();
+  cancelled_ = false;
+
+  if (fd_ >= 0)
+    close(fd_);
+  active_ = false;
+  fd_ = -1;
+  size_ = 0;
+  literal_.clear();
+  regex_.reset();
+  scanned_ = 0;
+  published_.clear();
+  published_finished_ = false;
+  finished_ = false;
+  matches_.clear();
+
+  uint64_t count;
+  while (read(event_fd_, &count, sizeof(count)) > 0) {
+  }
+}
+
+bool LogSearch::Collect() {
+  uint64_t count;
+  while (read(event_fd_, &count, sizeof(count)) > 0) {
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool changed = !published_.empty() || published_finished_ != finished_;
+  matches_.insert(matches_.end(), published_.begin(), published_.end());
+  published_.clear();
+  finished_ = published_finished_;
+  return changed;
+}
+
+double LogSearch::progress() const {
+  return size_ ? static_cast<double>(scanned_) / size_ : 1.0;
+}
+
+std::string LogSearch::Text(size_t start, size_t end) const {
+  std::string text(std::min(end - start, kMaxTextBytes), '\0');
+  text.resize(ReadAt(fd_, text.data(), text.size(), start));
+  return text;
+}
+
+void LogSearch::Search() {
+  std::vector<Match> found;
+  Window window;
+  size_t size = size_;
+  size_t position = 0;
+  while (position < size && !cancelled_) {
+    size_t end = std::min(size, position + kWindow);
+    // The lines of the candidates found in [position, end) may start before
+    // it, and end after it.
+    window.begin = position > kMaxLineScan ? position - kMaxLineScan : 0;
+    window.data.resize(std::min(size, end + literal_.size() + kMaxLineScan) -
+                       window.begin);
+    window.data.resize(
+        ReadAt(fd_, window.data.data(), window.data.size(), window.begin));
+    window.end = window.begin + window.data.size();
+    // The file got shorter: search what is left of it.
+    if (window.end <= position)
+      break;
+    if (window.end < end)
+      size = end = window.end;
+
+    position = literal_.empty() ? ScanLines(position, end, window, found)
+                                : ScanLiteral(position, end, window, found);
+    scanned_ = position;
+    if (!found.empty())
+      Publish(found, false);
+  }
+  Publish(found, true);
+}
+
+size_t LogSearch::ScanLiteral(size_t begin,
+                              size_t end,
+                              const Window& window,
+                              std::vector<Match>& found) {
+  // Candidates starting before |end| may finish after it.
+  size_t limit = std::min(window.end, end + literal_.size() - 1);
+  size_t position = begin;
+  for (;;) {
+    auto* hit = static_cast<const char*>(memmem(
+        window.At(position), limit - position, literal_.data(),
+        literal_.size()));
+    if (!hit)
+      return end;
+    size_t offset = window.Offset(hit);
+
+    size_t low = std::max(window.begin,
+                          offset > kMaxLineScan ? offset - kMaxLineScan : 0);
+    auto* newline = static_cast<const char*>(
+        memrchr(window.At(low), '\n', offset - low));
+    size_t start = newline ? window.Offset(newline) + 1 : low;
+    size_t stop = std::min(window.end, offset + kMaxLineScan);
+    newline = static_cast<const char*>(memchr(hit, '\n', stop - offset));
+    stop = newline ? window.Offset(newline) : stop;
+
+    TryLine(start, stop, offset, window, found);
+    // One match per line.
+    size_t next = std::min(window.end, stop + 1);
+    if (next >= end || cancelled_)
+      return next;
+    position = next;
+  }
+}
+
+size_t LogSearch::ScanLines(size_t begin,
+                            size_t end,
+                            const Window& window,
+                            std::vector<Match>& found) {
+  // Checking for cancellation at every line: a regular expression may take
+  // long on each one when no literal skips them.
+  size_t start = begin;
+  while (start < end && !cancelled_) {
+    size_t stop = std::min(window.end, start + kMaxLineScan);
+    auto* newline = static_cast<const char*>(
+        memchr(window.At(start), '\n', stop - start));
+    stop = newline ? window.Offset(newline) : stop;
+    TryLine(start, stop, start, window, found);
+    start = std::min(window.end, stop + 1);
+  }
+  return start;
+}
+
+void LogSearch::TryLine(size_t start,
+                        size_t end,
+                        size_t hit,
+                        const Window& window,
+                        std::vector<Match>& found) {
+  if (!regex_) {
+    found.push_back({start, end, hit, hit + literal_.size()});
+    return;
+  }
+  std::cmatch match;
+  if (!std::regex_search(window.At(start), window.At(end), match, *regex_))
+    return;
+  size_t match_start = start + match.position(0);
+  found.push_back(
+      {start, end, match_start, match_start + match.length(0)});
+}
+
+void LogSearch::Publish(std::vector<Match>& found, bool finished) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    published_.insert(published_.end(), found.begin(), found.end());
+    published_finished_ = finished;
+  }
+  found.clear();
+  // Only fails when interrupted, or when the counter is about to overflow,
+  // in which case it is readable anyway.
+  uint64_t one = 1;
+  while (write(event_fd_, &one, sizeof(one)) < 0 && errno == EINTR) {
+  }
+}
+
+class LogMatchesNode : public Node {
+ public:
+  explicit LogMatchesNode(LogSearch* search) : search_(search) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = 0;
+    requirement_.min_y = 1;
+    requirement_.flex_grow_x = 1;
+    requirement_.flex_grow_y = 1;
+    requirement_.flex_shrink_x = 1;
+    requirement_.flex_shrink_y = 1;
+  }
+
+  void Render(Screen& screen) override {
+    // The last match at the bottom, as in log_tail().
+    size_t i = search_->size();
+    for (int y = box_.y_max; y >= box_.y_min && i > 0; --y) {
+      const LogSearch::Match& match = (*search_)[--i];
+      std::string line = search_->Text(match.line_start, match.line_end);
+      std::string_view text = line;
+      size_t start =
+          std::min(text.size(), match.match_start - match.line_start);
+      size_t end = std::min(text.size(), match.match_end - match.line_start);
+      int x = box_.x_min;
+      x = DrawLogLine(screen, x, box_.x_max, y, text.substr(0, start));
+      int highlight = x;
+      x = DrawLogLine(screen, x, box_.x_max, y,
+                      text.substr(start, end - start));
+      for (; highlight < x; ++highlight)
+        screen.PixelAt(highlight, y).inverted = true;
+      DrawLogLine(screen, x, box_.x_max, y, text.substr(end));
+    }
+  }
+
+ private:
+  LogSearch* search_;
+};
+
+Element log_matches(LogSearch& search) {
+  return std::make_shared<LogMatchesNode>(&search);
+}
+
+}  // namespace app
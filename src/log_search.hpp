@@ -0,0 +1,137 @@
+#ifndef FTXUI_STARTER_LOG_SEARCH_HPP
+#define FTXUI_STARTER_LOG_SEARCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ftxui/dom/elements.hpp"
+
+namespace app {
+
+// The longest run of characters that every match of the ECMAScript regular
+// expression |pattern| contains, or nothing if there is an alternation.
+// |literal| is set to whether the pattern matches that text and nothing else.
+std::optional<std::string> RequiredLiteral(std::string_view pattern,
+                                           bool* literal);
+
+// Searches a log file for the lines matching a regular expression, on a
+// background thread. The file is opened again, so that the search does not
+// depend on the LogFile being followed, and read with pread in windows: it may
+// be truncated while searched, which would raise SIGBUS in a mapping.
+//
+// Only the lines containing the literal part of the pattern are given to the
+// regular expression; they are found with memmem, which glibc vectorizes, and
+// most lines of a log are skipped without being looked at. Lines are cut a few
+// KiB around the candidates, for the regular expression to stay within the
+// thread's stack. Matches are published as they are found, and fd() becomes
+// readable: the first ones can be shown while the rest of the file is
+// searched.
+//
+// Usage:
+//   LogSearch search;
+//   loop.Watch(search.fd(), [&] { if (search.Collect()) Redraw(); });
+//   search.Start("/var/log/syslog", "error: .*timeout");
+class LogSearch {
+ public:
+  struct Match {
+    // Offsets, in the file, of the line and of the text matched in it.
+    size_t line_start;
+    size_t line_end;
+    size_t match_start;
+    size_t match_end;
+  };
+
+  LogSearch();
+  ~LogSearch();
+  LogSearch(const LogSearch&) = delete;
+  LogSearch& operator=(const LogSearch&) = delete;
+
+  // Stops the previous search and searches the file at |path|, as it is now,
+  // for |pattern|. Returns false if the pattern is not a valid regular
+  // expression or the file cannot be read.
+  bool Start(const std::string& path, const std::string& pattern);
+  // Stops searching and forgets the matches.
+  void Stop();
+
+  int fd() const { return event_fd_; }
+  // Takes the matches published since the last call. Returns whether there
+  // were any, or the search has just finished.
+  bool Collect();
+
+  bool active() const { return active_; }
+  bool running() const { return active() && !finished_; }
+  // Share of the file searched, from 0 to 1.
+  double progress() const;
+
+  size_t size() const { return matches_.size(); }
+  const Match& operator[](size_t i) const { return matches_[i]; }
+  // The text of the file from |start| to |end|, cut to what a terminal line
+  // shows, read on each call.
+  std::string Text(size_t start, size_t end) const;
+
+ private:
+  // The part of the file read by the search thread, from |begin| to |end|.
+  struct Window {
+    std::string data;
+    size_t begin = 0;
+    size_t end = 0;
+
+    const char* At(size_t offset) const {
+      return data.data() + (offset - begin);
+    }
+    size_t Offset(const char* it) const { return begin + (it - data.data()); }
+  };
+
+  void Search();
+  // Search the lines holding a candidate starting in [begin, end), and return
+  // where the next window starts.
+  size_t ScanLiteral(size_t begin,
+                     size_t end,
+                     const Window& window,
+                     std::vector<Match>& found);
+  size_t ScanLines(size_t begin,
+                   size_t end,
+                   const Window& window,
+                   std::vector<Match>& found);
+  // Adds the line [start, end) to |found| if it matches. |hit| is where the
+  // literal was found in it.
+  void TryLine(size_t start,
+               size_t end,
+               size_t hit,
+               const Window& window,
+               std::vector<Match>& found);
+  // Hands |found| to the UI thread.
+  void Publish(std::vector<Match>& found, bool finished);
+
+  int event_fd_ = -1;
+  bool active_ = false;
+  int fd_ = -1;
+  size_t size_ = 0;
+  std::string literal_;
+  std::optional<std::regex> regex_;
+
+  std::thread thread_;
+  std::atomic<bool> cancelled_ = false;
+  std::atomic<size_t> scanned_ = 0;
+
+  std::mutex mutex_;
+  std::vector<Match> published_;  // Guarded by |mutex_|.
+  bool published_finished_ = false;  // Guarded by |mutex_|.
+  bool finished_ = false;
+  std::vector<Match> matches_;
+};
+
+// The last matches of |search| that fit in the space given, the matched text
+// highlighted.
+ftxui::Element log_matches(LogSearch& search);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_LOG_SEARCH_HPP
@@ -0,0 +1,301 @@
+#include "log_tail.hpp"
+
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "ftxui/dom/node.hpp"
+#include "ftxui/screen/string.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+// Bytes of a line decoded for display: enough for any terminal, however long
+// the line.
+constexpr size_t kMaxLineBytes = 1024;
+// Bytes searched for the start of a line before cutting it, so that a file
+// without newlines does not have to be read whole.
+constexpr size_t kMaxLineScan = 1 << 20;
+// Bytes read at once while searching backward for the start of a line.
+constexpr size_t kReadChunk = 64 << 10;
+// Lines kept as the file grows: many more than any terminal shows.
+constexpr size_t kMaxLines = 1024;
+
+// Renames and deletions need no watch: the open descriptor keeps following
+// the old file, to which the writer may still append, until the directory
+// watch sees the new one created.
+constexpr uint32_t kFileEvents = IN_MODIFY;
+constexpr uint32_t kDirectoryEvents = IN_CREATE | IN_MOVED_TO;
+
+std::string Directory(const std::string& path) {
+  size_t slash = path.rfind('/');
+  if (slash == std::string::npos)
+    return ".";
+  return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+std::string_view Basename(std::string_view path) {
+  size_t slash = path.rfind('/');
+  return slash == std::string_view::npos ? path : path.substr(slash + 1);
+}
+
+}  // namespace
+
+size_t ReadAt(int fd, char* buffer, size_t size, size_t offset) {
+  size_t done = 0;
+  while (done < size) {
+    ssize_t n = pread(fd, buffer + done, size - done,
+                      static_cast<off_t>(offset + done));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      break;
+    done += n;
+  }
+  return done;
+}
+
+LogFile::LogFile(std::string path) : path_(std::move(path)) {
+  Reopen();
+}
+
+LogFile::~LogFile() {
+  if (fd_ >= 0)
+    close(fd_);
+}
+
+void LogFile::Reset(size_t size) {
+  size_ = size;
+  data_.clear();
+  base_ = size;
+  starts_.clear();
+  scanned_ = size;
+}
+
+void LogFile::Reopen() {
+  if (fd_ >= 0)
+    close(fd_);
+  fd_ = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+  Reset(0);
+  Refresh();
+}
+
+bool LogFile::Refresh() {
+  struct stat status;
+  if (fd_ < 0 || fstat(fd_, &status) < 0)
+    return false;
+  size_t size = static_cast<size_t>(status.st_size);
+  if (size == size_)
+    return false;
+
+  // Truncated, or nothing indexed yet: stay lazy.
+  size_t old_size = size_;
+  if (size < old_size || scanned_ == old_size) {
+    Reset(size);
+    return true;
+  }
+
+  // Lines are being shown: read and index the new ones. A short read means
+  // the file is being truncated, which the next Refresh() sees.
+  data_.resize(size - base_);
+  size = old_size +
+         ReadAt(fd_, &data_[old_size - base_], size - old_size, old_size);
+  data_.resize(size - base_);
+  size_ = size;
+
+  // The newline ending the old data, already scanned, starts a line now that
+  // data follows it.
+  if (size_ > old_size && *At(old_size - 1) == '\n')
+    starts_.push_back(old_size);
+  const char* end = At(size_);
+  for (const char* it = At(old_size); it < end;) {
+    auto* newline = static_cast<const char*>(memchr(it, '\n', end - it));
+    if (!newline || newline + 1 == end)
+      break;
+    starts_.push_back(newline + 1 - At(base_) + base_);
+    it = newline + 1;
+  }
+  Trim();
+  return true;
+}
+
+void LogFile::Trim() {
+  if (starts_.size() <= kMaxLines)
+    return;
+  starts_.erase(starts_.begin(), starts_.end() - kMaxLines);
+  // Where IndexBackward() would have stopped: on the newline before the
+  // first line, unless the line was cut.
+  size_t first = starts_.front();
+  scanned_ = *At(first - 1) == '\n' ? first - 1 : first;
+  data_.erase(0, scanned_ - base_);
+  base_ = scanned_;
+}
+
+bool LogFile::ReadFrom(size_t offset) {
+  if (offset >= base_)
+    return true;
+  std::string chunk(base_ - offset, '\0');
+  if (ReadAt(fd_, chunk.data(), chunk.size(), offset) < chunk.size())
+    return false;
+  data_.insert(0, chunk);
+  base_ = offset;
+  return true;
+}
+
+void LogFile::IndexBackward(size_t count) {
+  while (starts_.size() < count && scanned_ > 0) {
+    // The line ending at |scanned_| starts after the newline before it.
+    size_t limit = scanned_ > kMaxLineScan ? scanned_ - kMaxLineScan : 0;
+    size_t end = scanned_;
+    const char* newline = nullptr;
+    while (!newline && end > limit) {
+      size_t low = end - limit > kReadChunk ? end - kReadChunk : limit;
+      if (!ReadFrom(low))
+        return;
+      newline = static_cast<const char*>(
+          memrchr(At(low), '\n', end - low));
+      end = low;
+    }
+    if (!newline) {
+      // The start of the file, or a line so long that it is cut.
+      starts_.push_front(limit);
+      scanned_ = limit;
+      continue;
+    }
+    // No line starts at the end of the file.
+    size_t position = newline - At(base_) + base_;
+    if (position + 1 < size_)
+      starts_.push_front(position + 1);
+    scanned_ = position;
+  }
+}
+
+std::string_view LogFile::LineFromEnd(size_t i) {
+  IndexBackward(i + 1);
+  if (i >= starts_.size())
+    return {};
+  size_t index = starts_.size() - 1 - i;
+  size_t start = starts_[index];
+  size_t end = index + 1 < starts_.size() ? starts_[index + 1] : size_;
+  if (end > start && *At(end - 1) == '\n')
+    end--;
+  return std::string_view(At(start), end - start);
+}
+
+LogFollower::LogFollower()
+    : inotify_fd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {}
+
+LogFollower::~LogFollower() {
+  if (inotify_fd_ >= 0)
+    close(inotify_fd_);
+}
+
+LogFile& LogFollower::Add(const std::string& path) {
+  size_t index = files_.size();
+  files_.push_back(std::make_unique<LogFile>(path));
+  file_watches_.push_back(-1);
+  WatchFile(index);
+
+  // The same directory gets the same watch descriptor.
+  int directory = inotify_add_watch(inotify_fd_, Directory(path).c_str(),
+                                    kDirectoryEvents);
+  if (directory >= 0)
+    directory_watches_[directory].push_back(index);
+  return *files_[index];
+}
+
+void LogFollower::WatchFile(size_t index) {
+  file_watches_[index] = inotify_add_watch(
+      inotify_fd_, files_[index]->path().c_str(), kFileEvents);
+}
+
+bool LogFollower::Dispatch() {
+  alignas(inotify_event) char buffer[4096];
+  bool changed = false;
+  for (;;) {
+    ssize_t size = read(inotify_fd_, buffer, sizeof(buffer));
+    if (size <= 0)
+      break;
+    for (char* it = buffer; it < buffer + size;) {
+      auto* event = reinterpret_cast<inotify_event*>(it);
+      it += sizeof(inotify_event) + event->len;
+
+      // A file was written to. After a rotation, the writer may still be
+      // appending to the old file until it reopens the new one.
+      for (size_t i = 0; i < files_.size(); ++i) {
+        if (file_watches_[i] == event->wd && (event->mask & IN_MODIFY))
+          changed |= files_[i]->Refresh();
+      }
+
+      // A file was created again.
+      auto directory = directory_watches_.find(event->wd);
+      if (directory == directory_watches_.end() || !event->len)
+        continue;
+      for (size_t i : directory->second) {
+        if (Basename(files_[i]->path()) != event->name)
+          continue;
+        if (file_watches_[i] >= 0)
+          inotify_rm_watch(inotify_fd_, file_watches_[i]);
+        files_[i]->Reopen();
+        WatchFile(i);
+        changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
+int DrawLogLine(Screen& screen,
+                int x,
+                int x_max,
+                int y,
+                std::string_view line) {
+  line = line.substr(0, kMaxLineBytes);
+  for (std::string& glyph : Utf8ToGlyphs(std::string(line))) {
+    if (x > x_max)
+      break;
+    // Tabs and other control characters would move the cursor.
+    if (glyph.size() == 1 && static_cast<unsigned char>(glyph[0]) < 0x20)
+      glyph = " ";
+    screen.PixelAt(x++, y).character = std::move(glyph);
+  }
+  return x;
+}
+
+class LogTailNode : public Node {
+ public:
+  explicit LogTailNode(LogFile* file) : file_(file) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = 0;
+    requirement_.min_y = 1;
+    requirement_.flex_grow_x = 1;
+    requirement_.flex_grow_y = 1;
+    requirement_.flex_shrink_x = 1;
+    requirement_.flex_shrink_y = 1;
+  }
+
+  void Render(Screen& screen) override {
+    // The last line at the bottom, the older ones above.
+    size_t i = 0;
+    for (int y = box_.y_max; y >= box_.y_min; --y, ++i)
+      DrawLogLine(screen, box_.x_min, box_.x_max, y, file_->LineFromEnd(i));
+  }
+
+ private:
+  LogFile* file_;
+};
+
+Element log_tail(LogFile& file) {
+  return std::make_shared<LogTailNode>(&file);
+}
+
+}  // namespace app
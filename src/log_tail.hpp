@@ -0,0 +1,124 @@
+#ifndef FTXUI_STARTER_LOG_TAIL_HPP
+#define FTXUI_STARTER_LOG_TAIL_HPP
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/screen.hpp"
+
+namespace app {
+
+// A log file, of which only the end is read. Lines are indexed lazily from the
+// end: showing the last lines of a file of any size only reads those lines.
+//
+// The file is read with pread into a buffer of its own rather than mapped: a
+// mapping of a file truncated behind our back, as logrotate's copytruncate
+// does, raises SIGBUS when the pages past its new end are touched.
+class LogFile {
+ public:
+  explicit LogFile(std::string path);
+  ~LogFile();
+  LogFile(const LogFile&) = delete;
+  LogFile& operator=(const LogFile&) = delete;
+
+  const std::string& path() const { return path_; }
+  bool is_open() const { return fd_ >= 0; }
+  size_t size() const { return size_; }
+
+  // Reads the data appended since the last call, or forgets what was read if
+  // the file was truncated. Returns whether the content changed.
+  bool Refresh();
+  // Opens |path| again, after the file was replaced.
+  void Reopen();
+
+  // The |i|th line counted from the last one, without its newline, valid
+  // until the next call. Empty past the first line.
+  std::string_view LineFromEnd(size_t i);
+
+ private:
+  // Forgets the lines read so far, as if the file was |size| bytes long and
+  // none of it was read yet.
+  void Reset(size_t size);
+  // Reads the file from |offset| up to what is already read. Returns false if
+  // the file got shorter.
+  bool ReadFrom(size_t offset);
+  // Indexes lines backward until |count| are known, or the start is reached.
+  void IndexBackward(size_t count);
+  // Forgets the oldest lines when more than kMaxLines are known.
+  void Trim();
+  // The byte at |offset| in the file, which must be read.
+  const char* At(size_t offset) const { return data_.data() + offset - base_; }
+
+  std::string path_;
+  int fd_ = -1;
+  size_t size_ = 0;
+  // The bytes of the file from |base_| to |size_|.
+  std::string data_;
+  size_t base_ = 0;
+  // Offsets of the starts of the lines found so far, in order. Every line
+  // starting at or after |scanned_| is known.
+  std::deque<size_t> starts_;
+  size_t scanned_ = 0;
+};
+
+// Follows LogFiles as they grow, are truncated, or are replaced by log
+// rotation, with one inotify descriptor to be watched by an EventLoop.
+//
+// Usage:
+//   LogFollower logs;
+//   LogFile& syslog = logs.Add("/var/log/syslog");
+//   loop.Watch(logs.fd(), [&] { if (logs.Dispatch()) Redraw(); });
+class LogFollower {
+ public:
+  LogFollower();
+  ~LogFollower();
+  LogFollower(const LogFollower&) = delete;
+  LogFollower& operator=(const LogFollower&) = delete;
+
+  // Starts following |path|. The file lives as long as the follower.
+  LogFile& Add(const std::string& path);
+
+  int fd() const { return inotify_fd_; }
+  size_t size() const { return files_.size(); }
+  LogFile& operator[](size_t i) { return *files_[i]; }
+
+  // Handles the pending notifications. Returns whether a file changed.
+  bool Dispatch();
+
+ private:
+  void WatchFile(size_t index);
+
+  int inotify_fd_ = -1;
+  std::vector<std::unique_ptr<LogFile>> files_;
+  // Watch descriptor of every file, and of the directories where they may be
+  // created again.
+  std::vector<int> file_watches_;
+  std::unordered_map<int, std::vector<size_t>> directory_watches_;
+};
+
+// Reads up to |size| bytes of |fd| at |offset| into |buffer|, retrying
+// interrupted and partial reads. Returns the number of bytes read, fewer at
+// the end of the file.
+size_t ReadAt(int fd, char* buffer, size_t size, size_t offset);
+
+// Draws |line| on row |y| of |screen|, from column |x| to at most |x_max|.
+// Control characters are shown as spaces. Returns the column after the line.
+int DrawLogLine(ftxui::Screen& screen,
+                int x,
+                int x_max,
+                int y,
+                std::string_view line);
+
+// The last lines of |file| that fit in the space given. Only those lines are
+// read.
+ftxui::Element log_tail(LogFile& file);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_LOG_TAIL_HPP
@@ -1,37 +1,213 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
 
+#include "dashboard.hpp"
+#include "fit_render.hpp"
 #include "ftxui/dom/elements.hpp"
 #include "ftxui/screen/screen.hpp"
 #include "ftxui/screen/string.hpp"
 
-int main(void) {
-  using namespace ftxui;
+#if defined(__linux__)
+#include <unistd.h>
 
-  auto summary = [&] {
-    auto content = vbox({
-        hbox({text(L"- done:   "), text(L"3") | bold}) | color(Color::Green),
-        hbox({text(L"- active: "), text(L"2") | bold}) | color(Color::RedLight),
-        hbox({text(L"- queue:  "), text(L"9") | bold}) | color(Color::Red),
-    });
-    return window(text(L" Summary "), content);
+#include "event_loop.hpp"
+#include "fanout_server.hpp"
+#include "interactive_app.hpp"
+#include "job_sources.hpp"
+#include "latency_histogram.hpp"
+#include "layout_worker.hpp"
+#include "metrics_server.hpp"
+#endif
+
+using namespace ftxui;
+
+namespace {
+
+#if defined(__linux__)
+
+void PrintUsage(const char* program) {
+  std::cerr << "Usage: " << program << "\n"
+            << "       " << program
+            << " --interactive [--latency-file <path>] [log files...]\n"
+            << "       " << program
+            << " --serve <unix:path|tcp:[host:]port>... [--fps <frames>]\n"
+            << "           [--source mock|stdin] [--latency-file <path>]\n"
+            << "           [--metrics <unix:path|tcp:[host:]port>]"
+            << std::endl;
+}
+
+// Renders the dashboard once per frame and width bucket, on a worker thread,
+// and fans it out to every client connected to |addresses|. The counters come
+// from |source|: "mock", or "stdin" for "<done> <active> <queue>" lines. The
+// time each frame takes from its request to its first publication is written
+// to |latency_path|, and the counters are served to scrapers on
+// |metrics_address|, unless empty.
+int Serve(const std::vector<std::string>& addresses,
+          int fps,
+          const std::string& source_name,
+          const std::string& latency_path,
+          const std::string& metrics_address) {
+  app::FanoutServer server;
+  // Panels get unreadable below 20 columns, and the document stops growing at
+  // 80 columns.
+  app::LayoutWorker layouts(20, 80);
+  // Keep RGB colors intact: they are downsampled for each client.
+  Terminal::SetColorSupport(Terminal::TrueColor);
+  for (const std::string& address : addresses) {
+    if (!server.Listen(address)) {
+      std::cerr << "Cannot listen on " << address << ": "
+                << std::strerror(errno) << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cerr << "Serving on " << address << std::endl;
+  }
+  app::MetricsServer metrics;
+  if (!metrics_address.empty()) {
+    if (!metrics.Listen(metrics_address)) {
+      std::cerr << "Cannot listen on " << metrics_address << ": "
+                << std::strerror(errno) << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cerr << "Serving metrics on " << metrics_address << std::endl;
+  }
+
+  app::EventLoop loop;
+  loop.Watch(server.fd(), [&] { server.Dispatch(0); });
+  bool swapped = false;
+  loop.Watch(layouts.fd(), [&] { swapped |= layouts.Swap(); });
+  loop.Watch(metrics.fd(), [&] { metrics.Dispatch(0); });
+  if (!metrics_address.empty())
+    loop.AddTimer(std::chrono::seconds(1), [&] { metrics.Sweep(); });
+  loop.OnSignal(SIGINT, [&] { loop.Quit(); });
+  loop.OnSignal(SIGTERM, [&] { loop.Quit(); });
+
+  app::Source<app::Jobs> source =
+      source_name == "stdin" ? app::ReadJobs(loop, STDIN_FILENO)
+                             : app::MockJobs(loop, std::chrono::seconds(1));
+  // The document is only rebuilt and laid out when the source yields, at the
+  // widths of the current frame, while the current frame is still served.
+  app::Jobs jobs;
+  bool changed = true;
+  source.Start([&](const app::Jobs& update) {
+    jobs = update;
+    changed = true;
+    metrics.Update(jobs);
+  });
+
+  // A frame is timed from its request to the first tick publishing it, the
+  // layout on the worker thread included. One laid out in time is shown one
+  // period after its request: the budget is two.
+  auto period = std::chrono::milliseconds(1000 / fps);
+  app::FrameLatencyMonitor latency(
+      "ftxui_starter_publish",
+      "Time from the request of a frame to the first publication of it.",
+      2 * period);
+  auto publish = [&] {
+    if (changed) {
+      layouts.Request([jobs] { return app::Dashboard(jobs); },
+                      layouts.front().Buckets());
+      changed = false;
+    }
+    server.Publish(layouts.front());
+    if (swapped) {
+      latency.Record(std::chrono::steady_clock::now() - layouts.requested());
+      swapped = false;
+    }
   };
+  publish();
+  loop.AddTimer(period, publish);
+  if (!latency_path.empty()) {
+    loop.AddTimer(std::chrono::seconds(10),
+                  [&] { latency.WriteFile(latency_path); });
+  }
+  loop.Run();
+  if (!latency_path.empty())
+    latency.WriteFile(latency_path);
+
+  return EXIT_SUCCESS;
+}
+
+#endif
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+#if defined(__linux__)
+  // ftxui-starter --interactive [--latency-file frames.prom] [log files...]
+  if (argc >= 2 && std::string(argv[1]) == "--interactive") {
+    std::string latency_path;
+    int first_log = 2;
+    if (argc >= 4 && std::string(argv[2]) == "--latency-file") {
+      latency_path = argv[3];
+      first_log = 4;
+    }
+    std::vector<std::string> logs(argv + first_log, argv + argc);
+    app::InteractiveApp interactive(app::JobList::Synthetic(1000000), logs);
+    interactive.ExportLatency(latency_path);
+    return interactive.Run();
+  }
+
+  // ftxui-starter --serve unix:/tmp/dashboard.sock --serve tcp:7000 --fps 10
+  //               --source stdin --latency-file publish.prom
+  //               --metrics tcp:127.0.0.1:9100
+  std::vector<std::string> addresses;
+  int fps = 10;
+  std::string source = "mock";
+  std::string latency_path;
+  std::string metrics_address;
+  for (int i = 1; i < argc; i += 2) {
+    std::string flag = argv[i];
+    if (i + 1 == argc) {
+      std::cerr << "Missing value after " << flag << std::endl;
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    if (flag == "--serve") {
+      addresses.push_back(argv[i + 1]);
+    } else if (flag == "--fps") {
+      // Frames are timed in whole milliseconds.
+      fps = std::clamp(std::atoi(argv[i + 1]), 1, 1000);
+    } else if (flag == "--source") {
+      source = argv[i + 1];
+      if (source != "mock" && source != "stdin") {
+        std::cerr << "Unknown source " << source << std::endl;
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    } else if (flag == "--latency-file") {
+      latency_path = argv[i + 1];
+    } else if (flag == "--metrics") {
+      metrics_address = argv[i + 1];
+    } else {
+      std::cerr << "Unknown flag " << flag << std::endl;
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!addresses.empty())
+    return Serve(addresses, fps, source, latency_path, metrics_address);
+  // The other flags only apply to the server.
+  if (argc > 1) {
+    std::cerr << "No address to serve on" << std::endl;
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+#endif
+
+#if defined(__EMSCRIPTEN__)
+  // The page draws the frames by calling frame(), see browser_app.hpp.
+  return EXIT_SUCCESS;
+#endif
 
-  auto document =  //
-      vbox({
-          hbox({
-              summary(),
-              summary(),
-              summary() | flex,
-          }),
-          summary(),
-          summary(),
-      });
-
-  // Limit the size of the document to 80 char.
-  document = document | size(WIDTH, LESS_THAN, 80);
-
-  auto screen = Screen::Create(Dimension::Full(), Dimension::Fit(document));
-  Render(screen, document);
+  auto document = app::Dashboard(app::Jobs());
+  Screen screen(Dimension::Full().dimx, app::Measure(document).dimy);
+  app::RenderMeasured(screen, document);
 
   std::cout << screen.ToString() << '\0' << std::endl;
 
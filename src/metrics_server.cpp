@@ -0,0 +1,239 @@
+#include "metrics_server.hpp"
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string_view>
+#include <utility>
+
+#include "listen_socket.hpp"
+
+namespace app {
+
+namespace {
+
+constexpr int kMaxEvents = 64;
+// Longest request headers accepted. Scrapers send a few hundred bytes.
+constexpr size_t kMaxRequest = 8 << 10;
+
+std::shared_ptr<const std::string> Response(const char* status,
+                                            const std::string& body) {
+  std::string response = std::string("HTTP/1.1 ") + status + "\r\n";
+  response += "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n";
+  response += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+  response += "Connection: close\r\n\r\n";
+  response += body;
+  return std::make_shared<const std::string>(std::move(response));
+}
+
+std::string Metrics(const Jobs& jobs) {
+  std::string body =
+      "# HELP ftxui_starter_jobs Jobs in each state, as shown by the summary "
+      "panels.\n"
+      "# TYPE ftxui_starter_jobs gauge\n";
+  auto add = [&](const char* state, int value) {
+    body += "ftxui_starter_jobs{state=\"";
+    body += state;
+    body += "\"} " + std::to_string(value) + '\n';
+  };
+  add("done", jobs.done);
+  add("active", jobs.active);
+  add("queue", jobs.queue);
+  return body;
+}
+
+std::shared_ptr<const std::string> NotFound() {
+  static const auto response = Response("404 Not Found", "");
+  return response;
+}
+
+std::shared_ptr<const std::string> MethodNotAllowed() {
+  static const auto response = Response("405 Method Not Allowed", "");
+  return response;
+}
+
+}  // namespace
+
+MetricsServer::MetricsServer()
+    : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      metrics_(Response("200 OK", Metrics(jobs_))) {
+  serializations_++;
+}
+
+MetricsServer::~MetricsServer() {
+  for (auto& it : clients_)
+    close(it.first);
+  for (int fd : listeners_)
+    close(fd);
+  for (const std::string& path : unix_paths_)
+    unlink(path.c_str());
+  if (epoll_fd_ >= 0)
+    close(epoll_fd_);
+}
+
+bool MetricsServer::Listen(const std::string& address) {
+  std::string unix_path;
+  int fd = ListenSocket(address, &unix_path);
+  if (fd < 0)
+    return false;
+
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+    int error = errno;
+    close(fd);
+    if (!unix_path.empty())
+      unlink(unix_path.c_str());
+    errno = error;
+    return false;
+  }
+  listeners_.push_back(fd);
+  if (!unix_path.empty())
+    unix_paths_.push_back(unix_path);
+  return true;
+}
+
+void MetricsServer::Update(const Jobs& jobs) {
+  if (jobs.done == jobs_.done && jobs.active == jobs_.active &&
+      jobs.queue == jobs_.queue) {
+    return;
+  }
+  jobs_ = jobs;
+  metrics_ = Response("200 OK", Metrics(jobs_));
+  serializations_++;
+}
+
+void MetricsServer::Dispatch(int timeout_ms) {
+  epoll_event events[kMaxEvents];
+  int count = epoll_wait(epoll_fd_, events, kMaxEvents, timeout_ms);
+  for (int i = 0; i < count; ++i) {
+    int fd = events[i].data.fd;
+    uint32_t flags = events[i].events;
+
+    bool is_listener = false;
+    for (int listener : listeners_)
+      is_listener |= listener == fd;
+    if (is_listener) {
+      Accept(fd);
+      continue;
+    }
+
+    auto it = clients_.find(fd);
+    if (it == clients_.end())
+      continue;
+
+    if (flags & (EPOLLERR | EPOLLHUP)) {
+      Close(fd);
+      continue;
+    }
+
+    Client& client = it->second;
+    client.active = std::chrono::steady_clock::now();
+    bool open = client.response ? Flush(client) : Receive(client);
+    if (!open)
+      Close(fd);
+  }
+}
+
+void MetricsServer::Accept(int listener) {
+  for (;;) {
+    int fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0)
+      return;
+    if (clients_.size() >= kMaxClients) {
+      close(fd);
+      continue;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+      close(fd);
+      continue;
+    }
+    Client& client = clients_[fd];
+    client.fd = fd;
+    client.active = std::chrono::steady_clock::now();
+  }
+}
+
+void MetricsServer::Sweep() {
+  auto deadline = std::chrono::steady_clock::now() - kIdleTimeout;
+  std::vector<int> idle;
+  for (const auto& it : clients_) {
+    if (it.second.active < deadline)
+      idle.push_back(it.first);
+  }
+  for (int fd : idle)
+    Close(fd);
+}
+
+// Reads the request until the end of its headers, and starts writing the
+// response.
+bool MetricsServer::Receive(Client& client) {
+  char buffer[1024];
+  ssize_t n;
+  while ((n = recv(client.fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+    client.request.append(buffer, n);
+    if (client.request.size() > kMaxRequest)
+      return false;
+  }
+  bool closed = n == 0;
+  if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+    return false;
+  if (client.request.find("\r\n\r\n") == std::string::npos &&
+      client.request.find("\n\n") == std::string::npos) {
+    return !closed;
+  }
+
+  // "GET /metrics HTTP/1.1", the query string ignored.
+  std::string_view line = client.request;
+  line = line.substr(0, line.find_first_of("\r\n"));
+  size_t space = line.find(' ');
+  std::string_view method = line.substr(0, space);
+  std::string_view target =
+      space == std::string_view::npos ? "" : line.substr(space + 1);
+  target = target.substr(0, target.find_first_of(" ?"));
+
+  if (method != "GET")
+    client.response = MethodNotAllowed();
+  else if (target == "/metrics" || target == "/")
+    client.response = metrics_;
+  else
+    client.response = NotFound();
+  requests_++;
+
+  // The response is written with the socket's readiness to write.
+  epoll_event event = {};
+  event.events = EPOLLOUT;
+  event.data.fd = client.fd;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, client.fd, &event);
+  return Flush(client);
+}
+
+// Writes as much of the response as the socket accepts. Returns false once
+// it is all written, or the client is gone.
+bool MetricsServer::Flush(Client& client) {
+  const std::string& response = *client.response;
+  while (client.sent < response.size()) {
+    ssize_t n = send(client.fd, response.data() + client.sent,
+                     response.size() - client.sent,
+                     MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (n < 0)
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    client.sent += n;
+  }
+  return false;
+}
+
+void MetricsServer::Close(int fd) {
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  close(fd);
+  clients_.erase(fd);
+}
+
+}  // namespace app
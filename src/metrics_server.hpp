@@ -0,0 +1,93 @@
+#ifndef FTXUI_STARTER_METRICS_SERVER_HPP
+#define FTXUI_STARTER_METRICS_SERVER_HPP
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dashboard.hpp"
+
+namespace app {
+
+// Serves the job counters of the summary panels over HTTP, in the Prometheus
+// text format, for a scraper to poll at "GET /metrics".
+//
+// Everything happens on the thread calling Update() and Dispatch(), the one
+// drawing the frames, so there is nothing to lock. The whole HTTP response is
+// serialized by Update(), only when the counters change; a request is
+// answered by writing that buffer. A client still receiving an older response
+// keeps its own reference to it. Connections are closed after each response,
+// or by Sweep() once idle for too long; past kMaxClients, new connections are
+// refused.
+//
+// Usage:
+//   MetricsServer metrics;
+//   metrics.Listen("tcp:127.0.0.1:9100");
+//   loop.Watch(metrics.fd(), [&] { metrics.Dispatch(0); });
+//   loop.AddTimer(seconds(1), [&] { metrics.Sweep(); });
+//   metrics.Update(jobs);
+//   curl localhost:9100/metrics
+class MetricsServer {
+ public:
+  // Scrapers time out after 10 seconds by default: a client that sent or
+  // read nothing for that long is not coming back.
+  static constexpr std::chrono::seconds kIdleTimeout{10};
+  static constexpr size_t kMaxClients = 64;
+
+  MetricsServer();
+  ~MetricsServer();
+  MetricsServer(const MetricsServer&) = delete;
+  MetricsServer& operator=(const MetricsServer&) = delete;
+
+  // Starts accepting scrapers on |address|, as FanoutServer::Listen() does.
+  bool Listen(const std::string& address);
+
+  // Serves |jobs| from now on.
+  void Update(const Jobs& jobs);
+
+  // Accepts new clients, reads their requests and writes the responses,
+  // waiting at most |timeout_ms| milliseconds for socket activity.
+  void Dispatch(int timeout_ms);
+  // Closes the connections idle for longer than kIdleTimeout.
+  void Sweep();
+
+  // The epoll file descriptor, readable whenever Dispatch() has work to do.
+  int fd() const { return epoll_fd_; }
+
+  // Requests answered, and times the response was serialized.
+  size_t requests() const { return requests_; }
+  size_t serializations() const { return serializations_; }
+
+ private:
+  struct Client {
+    int fd = -1;
+    // The request received so far, up to the end of its headers.
+    std::string request;
+    std::shared_ptr<const std::string> response;
+    size_t sent = 0;
+    // The last time the client sent or read anything.
+    std::chrono::steady_clock::time_point active;
+  };
+
+  void Accept(int listener);
+  // Returns false when the client is gone or done with.
+  bool Receive(Client& client);
+  bool Flush(Client& client);
+  void Close(int fd);
+
+  int epoll_fd_ = -1;
+  std::vector<int> listeners_;
+  std::vector<std::string> unix_paths_;
+  std::unordered_map<int, Client> clients_;
+
+  Jobs jobs_;
+  std::shared_ptr<const std::string> metrics_;
+  size_t requests_ = 0;
+  size_t serializations_ = 0;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_METRICS_SERVER_HPP
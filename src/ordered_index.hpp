@@ -0,0 +1,219 @@
+#ifndef FTXUI_STARTER_ORDERED_INDEX_HPP
+#define FTXUI_STARTER_ORDERED_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+
+namespace app {
+
+// A sorted set of keys supporting access by position: an indexable skip list.
+// Every link records how many positions it skips, so that inserting, erasing,
+// and finding the key at a given position all cost O(log n). Reading the k
+// keys following a position costs O(log n + k).
+//
+// Usage:
+//   OrderedIndex<int> index;
+//   index.Insert(42);
+//   for (auto cursor = index.Seek(first); cursor && count--; ++cursor)
+//     Show(*cursor);
+template <class Key, class Compare = std::less<Key>>
+class OrderedIndex {
+ private:
+  struct Node;
+
+  struct Link {
+    Node* node = nullptr;
+    // Number of positions between the two ends of the link. A null link goes
+    // one position past the last key.
+    size_t width = 1;
+  };
+
+  struct Node {
+    explicit Node(Key k) : key(std::move(k)) {}
+    Key key;
+    int level = 0;
+    Link next[1];  // |level| links, allocated with the node.
+  };
+
+ public:
+  static constexpr int kMaxLevel = 16;
+
+  // Reads the keys in order from a position.
+  class Cursor {
+   public:
+    explicit operator bool() const { return node_ != nullptr; }
+    const Key& operator*() const { return node_->key; }
+    const Key* operator->() const { return &node_->key; }
+    Cursor& operator++() {
+      node_ = node_->next[0].node;
+      ++position_;
+      return *this;
+    }
+    size_t position() const { return position_; }
+
+   private:
+    friend class OrderedIndex;
+    Cursor(const Node* node, size_t position)
+        : node_(node), position_(position) {}
+    const Node* node_;
+    size_t position_;
+  };
+
+  OrderedIndex() = default;
+  OrderedIndex(const OrderedIndex&) = delete;
+  OrderedIndex& operator=(const OrderedIndex&) = delete;
+  ~OrderedIndex() { Clear(); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Adds |key|. Returns false if an equivalent key is already present.
+  bool Insert(Key key) {
+    Link* update[kMaxLevel];
+    size_t ranks[kMaxLevel];
+    size_t rank = Search(key, update, ranks);
+    Node* next = update[0]->node;
+    if (next && !less_(key, next->key))
+      return false;
+
+    int level = RandomLevel();
+    Node* node = Allocate(std::move(key), level);
+    for (int i = 0; i < kMaxLevel; ++i) {
+      Link& link = *update[i];
+      if (i < level) {
+        node->next[i].node = link.node;
+        node->next[i].width = link.width - (rank - ranks[i]);
+        link.node = node;
+        link.width = rank - ranks[i] + 1;
+      } else {
+        link.width++;
+      }
+    }
+    size_++;
+    return true;
+  }
+
+  // Removes the key equivalent to |key|. Returns false if there is none.
+  bool Erase(const Key& key) {
+    Link* update[kMaxLevel];
+    size_t ranks[kMaxLevel];
+    Search(key, update, ranks);
+    Node* node = update[0]->node;
+    if (!node || less_(key, node->key))
+      return false;
+
+    for (int i = 0; i < kMaxLevel; ++i) {
+      Link& link = *update[i];
+      if (i < node->level) {
+        link.width += node->next[i].width - 1;
+        link.node = node->next[i].node;
+      } else {
+        link.width--;
+      }
+    }
+    Free(node);
+    size_--;
+    return true;
+  }
+
+  // Returns a cursor on the key at |position|, counted from 0, or a null
+  // cursor past the end.
+  Cursor Seek(size_t position) const {
+    if (position >= size_)
+      return Cursor(nullptr, size_);
+
+    const Link* links = head_;
+    const Node* node = nullptr;
+    size_t rank = 0;
+    for (int i = kMaxLevel - 1; i >= 0; --i) {
+      while (links[i].node && rank + links[i].width <= position + 1) {
+        rank += links[i].width;
+        node = links[i].node;
+        links = node->next;
+      }
+    }
+    return Cursor(node, position);
+  }
+
+  // Returns the number of keys ordered before |key|.
+  size_t Rank(const Key& key) const {
+    const Link* links = head_;
+    size_t rank = 0;
+    for (int i = kMaxLevel - 1; i >= 0; --i) {
+      while (links[i].node && less_(links[i].node->key, key)) {
+        rank += links[i].width;
+        links = links[i].node->next;
+      }
+    }
+    return rank;
+  }
+
+  void Clear() {
+    Node* node = head_[0].node;
+    while (node) {
+      Node* next = node->next[0].node;
+      Free(node);
+      node = next;
+    }
+    for (Link& link : head_)
+      link = Link();
+    size_ = 0;
+  }
+
+ private:
+  // Finds, at every level, the last link ending before |key|. Returns the
+  // number of keys before |key|, and the rank at which each link starts.
+  size_t Search(const Key& key, Link** update, size_t* ranks) {
+    Link* links = head_;
+    size_t rank = 0;
+    for (int i = kMaxLevel - 1; i >= 0; --i) {
+      while (links[i].node && less_(links[i].node->key, key)) {
+        rank += links[i].width;
+        links = links[i].node->next;
+      }
+      update[i] = &links[i];
+      ranks[i] = rank;
+    }
+    return rank;
+  }
+
+  // Each level holds a quarter of the keys of the level below.
+  int RandomLevel() {
+    random_ ^= random_ << 13;
+    random_ ^= random_ >> 7;
+    random_ ^= random_ << 17;
+    int level = 1;
+    for (uint64_t bits = random_; (bits & 3) == 0 && level < kMaxLevel;
+         bits >>= 2) {
+      level++;
+    }
+    return level;
+  }
+
+  static Node* Allocate(Key key, int level) {
+    size_t size = sizeof(Node) + (level - 1) * sizeof(Link);
+    void* memory = ::operator new(size);
+    Node* node = new (memory) Node(std::move(key));
+    node->level = level;
+    for (int i = 1; i < level; ++i)
+      new (&node->next[i]) Link();
+    return node;
+  }
+
+  static void Free(Node* node) {
+    node->~Node();
+    ::operator delete(node);
+  }
+
+  Link head_[kMaxLevel];
+  size_t size_ = 0;
+  uint64_t random_ = 0x9E3779B97F4A7C15ull;
+  Compare less_;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_ORDERED_INDEX_HPP
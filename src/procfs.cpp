@@ -0,0 +1,353 @@
+#include "procfs.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace app {
+
+namespace {
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t';
+}
+
+double Seconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+}  // namespace
+
+ProcFile::ProcFile(const char* path, size_t buffer_size)
+    : fd_(open(path, O_RDONLY | O_CLOEXEC)), buffer_(buffer_size) {}
+
+ProcFile::~ProcFile() {
+  Close();
+}
+
+void ProcFile::Close() {
+  if (fd_ >= 0)
+    close(fd_);
+  fd_ = -1;
+}
+
+ProcFile::ProcFile(ProcFile&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)), buffer_(std::move(other.buffer_)) {}
+
+ProcFile& ProcFile::operator=(ProcFile&& other) noexcept {
+  std::swap(fd_, other.fd_);
+  std::swap(buffer_, other.buffer_);
+  return *this;
+}
+
+std::string_view ProcFile::Read() {
+  if (fd_ < 0)
+    return {};
+  size_t size = 0;
+  for (;;) {
+    ssize_t read = pread(fd_, buffer_.data() + size, buffer_.size() - size,
+                         static_cast<off_t>(size));
+    if (read < 0) {
+      if (errno == EINTR)
+        continue;
+      if (errno == ESRCH)
+        Close();
+      return {};
+    }
+    if (read == 0) {
+      if (size == 0)
+        Close();
+      break;
+    }
+    size += read;
+    // The file may be longer than the buffer: grow it, once and for all.
+    if (size == buffer_.size())
+      buffer_.resize(buffer_.size() * 2);
+  }
+  return std::string_view(buffer_.data(), size);
+}
+
+void TextScanner::SkipSpaces() {
+  size_t i = 0;
+  while (i < text_.size() && IsSpace(text_[i]))
+    i++;
+  text_.remove_prefix(i);
+}
+
+std::string_view TextScanner::Word() {
+  SkipSpaces();
+  size_t i = 0;
+  while (i < text_.size() && !IsSpace(text_[i]) && text_[i] != '\n')
+    i++;
+  std::string_view word = text_.substr(0, i);
+  text_.remove_prefix(i);
+  return word;
+}
+
+bool TextScanner::Number(uint64_t& value) {
+  std::string_view word = Word();
+  auto result = std::from_chars(word.data(), word.data() + word.size(), value);
+  return result.ec == std::errc() && !word.empty();
+}
+
+bool TextScanner::Skip(int count) {
+  for (int i = 0; i < count; ++i) {
+    if (Word().empty())
+      return false;
+  }
+  return true;
+}
+
+bool TextScanner::SkipPastLast(char c) {
+  size_t end = std::min(text_.find('\n'), text_.size());
+  size_t position = text_.substr(0, end).rfind(c);
+  if (position == std::string_view::npos)
+    return false;
+  text_.remove_prefix(position + 1);
+  return true;
+}
+
+void TextScanner::NextLine() {
+  size_t end = text_.find('\n');
+  text_.remove_prefix(end == std::string_view::npos ? text_.size() : end + 1);
+}
+
+CpuCollector::CpuCollector() : stat_("/proc/stat") {}
+
+void CpuCollector::Sample() {
+  TextScanner scanner(stat_.Read());
+  // "cpu" sums up the cores, then come "cpu0", "cpu1", ...
+  scanner.NextLine();
+  for (size_t core = 0; !scanner.done(); ++core, scanner.NextLine()) {
+    std::string_view name = scanner.Word();
+    if (name.substr(0, 3) != "cpu")
+      break;
+
+    // user nice system idle iowait irq softirq steal
+    uint64_t values[8] = {};
+    for (uint64_t& value : values) {
+      if (!scanner.Number(value))
+        break;
+    }
+    Times times;
+    times.idle = values[3] + values[4];
+    for (uint64_t value : values)
+      times.total += value;
+
+    if (core >= last_.size()) {
+      last_.push_back(times);
+      cores_.emplace_back();
+      continue;
+    }
+    uint64_t total = times.total - last_[core].total;
+    uint64_t idle = times.idle - last_[core].idle;
+    cores_[core].Push(total ? 100.f * (total - idle) / total : 0.f);
+    last_[core] = times;
+  }
+}
+
+MemoryCollector::MemoryCollector() : meminfo_("/proc/meminfo") {}
+
+void MemoryCollector::Sample() {
+  uint64_t total = 0;
+  uint64_t available = 0;
+  TextScanner scanner(meminfo_.Read());
+  for (; !scanner.done() && !(total && available); scanner.NextLine()) {
+    std::string_view key = scanner.Word();
+    if (key == "MemTotal:")
+      scanner.Number(total);
+    else if (key == "MemAvailable:")
+      scanner.Number(available);
+  }
+  total_kb_ = total;
+  used_kb_ = total - std::min(total, available);
+  used_.Push(total ? 100.f * used_kb_ / total : 0.f);
+}
+
+IoCollector::IoCollector()
+    : diskstats_("/proc/diskstats"), net_dev_("/proc/net/dev") {
+  if (DIR* directory = opendir("/sys/block")) {
+    while (dirent* entry = readdir(directory)) {
+      std::string_view name = entry->d_name;
+      if (name[0] == '.' || name.substr(0, 4) == "loop" ||
+          name.substr(0, 3) == "ram") {
+        continue;
+      }
+      disks_.emplace_back(name);
+    }
+    closedir(directory);
+  }
+}
+
+bool IoCollector::IsDisk(std::string_view name) const {
+  return std::find(disks_.begin(), disks_.end(), name) != disks_.end();
+}
+
+IoCollector::Totals IoCollector::ReadTotals() {
+  // Sectors are 512 bytes, whatever the disk.
+  constexpr uint64_t kSector = 512;
+
+  Totals totals;
+  TextScanner disks(diskstats_.Read());
+  for (; !disks.done(); disks.NextLine()) {
+    // major minor name reads merged sectors ms writes merged sectors ...
+    uint64_t read = 0;
+    uint64_t written = 0;
+    if (!disks.Skip(2) || !IsDisk(disks.Word()) || !disks.Skip(2) ||
+        !disks.Number(read) || !disks.Skip(3) || !disks.Number(written)) {
+      continue;
+    }
+    totals.disk_read += read * kSector;
+    totals.disk_written += written * kSector;
+  }
+
+  TextScanner interfaces(net_dev_.Read());
+  // Two lines of headers.
+  interfaces.NextLine();
+  interfaces.NextLine();
+  for (; !interfaces.done(); interfaces.NextLine()) {
+    // name: bytes packets errs drop fifo frame compressed multicast bytes ...
+    // Some kernels glue the first number to the name.
+    TextScanner numbers = interfaces;
+    std::string_view name = numbers.Word();
+    name = name.substr(0, name.find(':'));
+    numbers = interfaces;
+    if (name == "lo" || !numbers.SkipPastLast(':'))
+      continue;
+    uint64_t received = 0;
+    uint64_t sent = 0;
+    if (!numbers.Number(received) || !numbers.Skip(7) ||
+        !numbers.Number(sent)) {
+      continue;
+    }
+    totals.received += received;
+    totals.sent += sent;
+  }
+  return totals;
+}
+
+void IoCollector::Sample() {
+  Totals totals = ReadTotals();
+  auto now = std::chrono::steady_clock::now();
+  double seconds = Seconds(now - last_time_);
+  if (sampled_ && seconds > 0) {
+    auto rate = [seconds](uint64_t current, uint64_t last) {
+      return current > last ? static_cast<float>((current - last) / seconds)
+                            : 0.f;
+    };
+    disk_read_.Push(rate(totals.disk_read, last_.disk_read));
+    disk_written_.Push(rate(totals.disk_written, last_.disk_written));
+    received_.Push(rate(totals.received, last_.received));
+    sent_.Push(rate(totals.sent, last_.sent));
+  }
+  last_ = totals;
+  last_time_ = now;
+  sampled_ = true;
+}
+
+ProcessCollector::ProcessCollector(int rescan_period)
+    : rescan_period_(std::max(1, rescan_period)),
+      ticks_per_second_(static_cast<double>(sysconf(_SC_CLK_TCK))) {}
+
+void ProcessCollector::Rescan() {
+  DIR* directory = opendir("/proc");
+  if (!directory)
+    return;
+
+  // Processes are kept sorted by pid, so that the ones still alive keep
+  // their open file and their last sample.
+  std::vector<Process> processes;
+  processes.reserve(processes_.size());
+  while (dirent* entry = readdir(directory)) {
+    int pid = 0;
+    const char* end = entry->d_name + std::strlen(entry->d_name);
+    auto result = std::from_chars(entry->d_name, end, pid);
+    if (result.ec != std::errc() || result.ptr != end)
+      continue;
+
+    auto it = std::lower_bound(
+        processes_.begin(), processes_.end(), pid,
+        [](const Process& process, int pid) { return process.pid < pid; });
+    if (it != processes_.end() && it->pid == pid && it->stat.is_open()) {
+      processes.push_back(std::move(*it));
+      continue;
+    }
+    char path[32];
+    std::snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    Process process;
+    process.pid = pid;
+    // A stat line is a few hundred bytes.
+    process.stat = ProcFile(path, 512);
+    if (process.stat.is_open())
+      processes.push_back(std::move(process));
+  }
+  closedir(directory);
+
+  std::sort(processes.begin(), processes.end(),
+            [](const Process& a, const Process& b) { return a.pid < b.pid; });
+  processes_ = std::move(processes);
+}
+
+void ProcessCollector::Sample() {
+  if (samples_++ % rescan_period_ == 0)
+    Rescan();
+
+  auto now = std::chrono::steady_clock::now();
+  double seconds = Seconds(now - last_time_);
+  last_time_ = now;
+
+  uint64_t total = 0;
+  uint64_t busiest = 0;
+  for (Process& process : processes_) {
+    // pid (name) state ppid pgrp session tty tpgid flags minflt cminflt
+    // majflt cmajflt utime stime ... The name may contain spaces and ')'.
+    std::string_view stat = process.stat.Read();
+    TextScanner scanner(stat);
+    uint64_t user = 0;
+    uint64_t system = 0;
+    if (!scanner.SkipPastLast(')') || !scanner.Skip(11) ||
+        !scanner.Number(user) || !scanner.Number(system)) {
+      continue;
+    }
+
+    uint64_t ticks = user + system;
+    uint64_t delta = process.sampled && ticks > process.ticks
+                         ? ticks - process.ticks
+                         : 0;
+    if (!process.sampled) {
+      size_t open = stat.find('(');
+      size_t close = stat.rfind(')');
+      if (open != std::string_view::npos && close > open) {
+        std::string_view name = stat.substr(open + 1, close - open - 1);
+        name = name.substr(0, sizeof(process.name) - 1);
+        std::memcpy(process.name, name.data(), name.size());
+        process.name[name.size()] = '\0';
+      }
+    }
+    process.ticks = ticks;
+    process.sampled = true;
+
+    total += delta;
+    if (delta > busiest) {
+      busiest = delta;
+      std::memcpy(busiest_name_, process.name, sizeof(busiest_name_));
+    }
+  }
+
+  if (samples_ == 1 || seconds <= 0)
+    return;
+  double scale = 100.0 / (ticks_per_second_ * seconds);
+  total_.Push(static_cast<float>(total * scale));
+  busiest_usage_ = static_cast<float>(busiest * scale);
+  if (!busiest)
+    busiest_name_[0] = '\0';
+}
+
+}  // namespace app
@@ -0,0 +1,183 @@
+#ifndef FTXUI_STARTER_PROCFS_HPP
+#define FTXUI_STARTER_PROCFS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ring_buffer.hpp"
+
+namespace app {
+
+// A file of /proc, opened once and read again from the start at every sample
+// with pread, into a buffer reused from one read to the next. The buffer
+// starts at |buffer_size| bytes, and grows to fit the file.
+class ProcFile {
+ public:
+  ProcFile() = default;
+  explicit ProcFile(const char* path, size_t buffer_size = 4096);
+  ~ProcFile();
+  ProcFile(ProcFile&& other) noexcept;
+  ProcFile& operator=(ProcFile&& other) noexcept;
+
+  bool is_open() const { return fd_ >= 0; }
+
+  // Returns the current content of the file, valid until the next call. Empty
+  // if the file cannot be read. The file is closed once it is of no more
+  // use, empty or failing with ESRCH after its process exited, so that the
+  // descriptor does not outlive the process.
+  std::string_view Read();
+
+ private:
+  void Close();
+
+  int fd_ = -1;
+  std::vector<char> buffer_;
+};
+
+// Reads numbers and words from procfs text, without allocating. Reading past
+// the end of a line fails instead of moving to the next one.
+class TextScanner {
+ public:
+  explicit TextScanner(std::string_view text) : text_(text) {}
+
+  bool done() const { return text_.empty(); }
+
+  // Returns the next word of the line, delimited by whitespace, or an empty
+  // string at the end of the line.
+  std::string_view Word();
+  // Reads the next word of the line as a number.
+  bool Number(uint64_t& value);
+  // Skips |count| words of the line. Returns false past the end of the line.
+  bool Skip(int count);
+  // Moves past the last |c| of the line.
+  bool SkipPastLast(char c);
+  // Moves to the start of the next line.
+  void NextLine();
+
+ private:
+  void SkipSpaces();
+
+  std::string_view text_;
+};
+
+// Values sampled over the last few seconds, at 10 Hz.
+using History = RingBuffer<float, 64>;
+
+// Usage of every core, in percent, from /proc/stat.
+class CpuCollector {
+ public:
+  CpuCollector();
+  void Sample();
+
+  // One history per core.
+  const std::vector<History>& cores() const { return cores_; }
+
+ private:
+  struct Times {
+    uint64_t idle = 0;
+    uint64_t total = 0;
+  };
+
+  ProcFile stat_;
+  std::vector<Times> last_;
+  std::vector<History> cores_;
+};
+
+// Memory in use, from /proc/meminfo.
+class MemoryCollector {
+ public:
+  MemoryCollector();
+  void Sample();
+
+  uint64_t total_kb() const { return total_kb_; }
+  uint64_t used_kb() const { return used_kb_; }
+  // Used memory, in percent.
+  const History& used() const { return used_; }
+
+ private:
+  ProcFile meminfo_;
+  uint64_t total_kb_ = 0;
+  uint64_t used_kb_ = 0;
+  History used_;
+};
+
+// Bytes read and written per second by the disks of /proc/diskstats, and
+// received and sent per second by the network interfaces of /proc/net/dev,
+// loopback excluded.
+class IoCollector {
+ public:
+  IoCollector();
+  void Sample();
+
+  const History& disk_read() const { return disk_read_; }
+  const History& disk_written() const { return disk_written_; }
+  const History& received() const { return received_; }
+  const History& sent() const { return sent_; }
+
+ private:
+  struct Totals {
+    uint64_t disk_read = 0;
+    uint64_t disk_written = 0;
+    uint64_t received = 0;
+    uint64_t sent = 0;
+  };
+  Totals ReadTotals();
+  bool IsDisk(std::string_view name) const;
+
+  ProcFile diskstats_;
+  ProcFile net_dev_;
+  // Whole disks, from /sys/block: partitions would count twice.
+  std::vector<std::string> disks_;
+  Totals last_;
+  std::chrono::steady_clock::time_point last_time_;
+  bool sampled_ = false;
+  History disk_read_;
+  History disk_written_;
+  History received_;
+  History sent_;
+};
+
+// CPU usage of every process, from /proc/<pid>/stat. The files stay open
+// between samples; the list of processes is refreshed every
+// |rescan_period| samples.
+class ProcessCollector {
+ public:
+  explicit ProcessCollector(int rescan_period = 10);
+  void Sample();
+
+  size_t count() const { return processes_.size(); }
+  // Usage of all the processes, in percent of one core.
+  const History& total() const { return total_; }
+  // The process using the most CPU at the last sample.
+  std::string_view busiest_name() const { return busiest_name_; }
+  float busiest_usage() const { return busiest_usage_; }
+
+ private:
+  struct Process {
+    int pid = 0;
+    ProcFile stat;
+    uint64_t ticks = 0;
+    bool sampled = false;
+    // The command name, at most 15 characters.
+    char name[16] = {};
+  };
+
+  void Rescan();
+
+  int rescan_period_;
+  int samples_ = 0;
+  double ticks_per_second_;
+  std::vector<Process> processes_;
+  std::chrono::steady_clock::time_point last_time_;
+  History total_;
+  char busiest_name_[16] = {};
+  float busiest_usage_ = 0;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_PROCFS_HPP
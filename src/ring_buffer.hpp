@@ -0,0 +1,40 @@
+#ifndef FTXUI_STARTER_RING_BUFFER_HPP
+#define FTXUI_STARTER_RING_BUFFER_HPP
+
+#include <array>
+#include <cstddef>
+
+namespace app {
+
+// The last N values pushed, in a fixed array: pushing never allocates, and
+// overwrites the oldest value once full.
+template <class T, size_t N>
+class RingBuffer {
+ public:
+  static constexpr size_t capacity() { return N; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void Push(const T& value) {
+    values_[(start_ + size_) % N] = value;
+    if (size_ < N)
+      size_++;
+    else
+      start_ = (start_ + 1) % N;
+  }
+
+  // The |i|th value, counted from the oldest.
+  const T& operator[](size_t i) const { return values_[(start_ + i) % N]; }
+  const T& back() const { return (*this)[size_ - 1]; }
+
+  void Clear() { start_ = size_ = 0; }
+
+ private:
+  std::array<T, N> values_ = {};
+  size_t start_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_RING_BUFFER_HPP
@@ -0,0 +1,48 @@
+#include "screen_pool.hpp"
+
+#include <algorithm>
+
+namespace app {
+
+using namespace ftxui;
+
+void ClearInPlace(Screen& screen) {
+  // Assigning the one-character string reuses the pixel's buffer.
+  static const Pixel blank;
+  for (int y = 0; y < screen.dimy(); ++y) {
+    for (int x = 0; x < screen.dimx(); ++x)
+      screen.PixelAt(x, y) = blank;
+  }
+  screen.SetCursor(Screen::Cursor{screen.dimx() - 1, screen.dimy() - 1});
+}
+
+ScreenPool::ScreenPool(size_t capacity)
+    : capacity_(std::max<size_t>(1, capacity)) {
+  entries_.reserve(capacity_);
+}
+
+Screen& ScreenPool::Get(int dimx, int dimy) {
+  ++uses_;
+  for (Entry& entry : entries_) {
+    if (entry.screen.dimx() == dimx && entry.screen.dimy() == dimy) {
+      entry.last_used = uses_;
+      ClearInPlace(entry.screen);
+      return entry.screen;
+    }
+  }
+
+  ++allocations_;
+  if (entries_.size() < capacity_) {
+    entries_.push_back({Screen(dimx, dimy), uses_});
+    return entries_.back().screen;
+  }
+  // Replace the screen that was used the least recently.
+  auto oldest = std::min_element(
+      entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) {
+        return a.last_used < b.last_used;
+      });
+  *oldest = {Screen(dimx, dimy), uses_};
+  return oldest->screen;
+}
+
+}  // namespace app
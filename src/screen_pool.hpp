@@ -0,0 +1,54 @@
+#ifndef FTXUI_STARTER_SCREEN_POOL_HPP
+#define FTXUI_STARTER_SCREEN_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ftxui/screen/screen.hpp"
+
+namespace app {
+
+// Blanks every pixel of |screen|, keeping its storage. Screen::Clear()
+// allocates a new grid of pixels instead.
+void ClearInPlace(ftxui::Screen& screen);
+
+// Keeps the Screens that frames are rendered into from one frame to the next,
+// so that a live loop rendering at the same size every frame allocates no
+// Screen memory once warm. A Screen is only allocated for a size that was not
+// used recently, e.g. when the terminal is resized.
+//
+// Usage:
+//   ScreenPool screens;
+//   for (;;) {
+//     Screen& screen = screens.Get(Terminal::Size().dimx, height);
+//     Render(screen, document);
+//     Write(encoder.Diff(screen));
+//   }
+class ScreenPool {
+ public:
+  // Keeps up to |capacity| screens of different sizes.
+  explicit ScreenPool(size_t capacity = 2);
+
+  // A blank screen of |dimx| by |dimy| cells. It is valid until the pool
+  // evicts it, after Get() is called with |capacity| other sizes.
+  ftxui::Screen& Get(int dimx, int dimy);
+
+  // Screens allocated so far, a measure of how well the pool is working.
+  size_t allocations() const { return allocations_; }
+
+ private:
+  struct Entry {
+    ftxui::Screen screen;
+    uint64_t last_used;
+  };
+
+  size_t capacity_;
+  std::vector<Entry> entries_;
+  uint64_t uses_ = 0;
+  size_t allocations_ = 0;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_SCREEN_POOL_HPP
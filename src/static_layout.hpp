@@ -0,0 +1,321 @@
+#ifndef FTXUI_STARTER_STATIC_LAYOUT_HPP
+#define FTXUI_STARTER_STATIC_LAYOUT_HPP
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "ftxui/screen/box.hpp"
+#include "ftxui/screen/color.hpp"
+#include "ftxui/screen/screen.hpp"
+
+// Layouts whose structure is known at compile time, described with types
+// instead of being built as an Element tree every frame:
+//
+//   inline constexpr char kDone[] = "- done: ";
+//   using Layout = Window<Label<kTitle>, HBox<Label<kDone>, Field<4>>>;
+//
+// The position of every Field is a constexpr function of the width, and the
+// static parts (labels, borders, styles) are drawn once. Each frame then only
+// writes the characters of the fields. Fields and labels hold single-width
+// ASCII characters.
+//
+// The nodes mirror the FTXUI elements of the same name, and distribute space
+// the same way when there is enough of it. Below the minimum width, children
+// are clipped instead of shrunk.
+namespace app {
+namespace layout {
+
+// Fixed text. |kText| must be a constexpr character array with linkage.
+template <const char* kText>
+struct Label {
+  static constexpr int kMinX = std::char_traits<char>::length(kText);
+  static constexpr int kMinY = 1;
+  static constexpr int kFlexX = 0;
+  static constexpr int kFlexY = 0;
+  static constexpr int kFields = 0;
+
+  template <class Visitor>
+  static constexpr void Visit(ftxui::Box box, int, Visitor& visitor) {
+    visitor.Text(box, std::string_view(kText, kMinX));
+  }
+};
+
+// One line of dynamic text, |kWidth| characters wide.
+template <int kWidth>
+struct Field {
+  static constexpr int kMinX = kWidth;
+  static constexpr int kMinY = 1;
+  static constexpr int kFlexX = 0;
+  static constexpr int kFlexY = 0;
+  static constexpr int kFields = 1;
+
+  template <class Visitor>
+  static constexpr void Visit(ftxui::Box box, int field, Visitor& visitor) {
+    box.y_max = box.y_min;
+    visitor.Field(field, box);
+  }
+};
+
+template <class... Children>
+struct HBox {
+  static constexpr int kMinX = (0 + ... + Children::kMinX);
+  static constexpr int kMinY = std::max({0, Children::kMinY...});
+  static constexpr int kFlexX = 0;
+  static constexpr int kFlexY = 0;
+  static constexpr int kFields = (0 + ... + Children::kFields);
+
+  template <class Visitor>
+  static constexpr void Visit(ftxui::Box box, int field, Visitor& visitor) {
+    int extra = box.x_max - box.x_min + 1 - kMinX;
+    int flex = (0 + ... + Children::kFlexX);
+    int x = box.x_min;
+    (VisitChild<Children>(box, x, extra, flex, field, visitor), ...);
+  }
+
+ private:
+  template <class Child, class Visitor>
+  static constexpr void VisitChild(ftxui::Box box,
+                                   int& x,
+                                   int& extra,
+                                   int& flex,
+                                   int& field,
+                                   Visitor& visitor) {
+    int added = 0;
+    if (extra > 0 && flex > 0) {
+      added = extra * Child::kFlexX / flex;
+      extra -= added;
+      flex -= Child::kFlexX;
+    }
+    ftxui::Box child = box;
+    child.x_min = x;
+    child.x_max = std::min(box.x_max, x + Child::kMinX + added - 1);
+    Child::Visit(child, field, visitor);
+    x += Child::kMinX + added;
+    field += Child::kFields;
+  }
+};
+
+template <class... Children>
+struct VBox {
+  static constexpr int kMinX = std::max({0, Children::kMinX...});
+  static constexpr int kMinY = (0 + ... + Children::kMinY);
+  static constexpr int kFlexX = 0;
+  static constexpr int kFlexY = 0;
+  static constexpr int kFields = (0 + ... + Children::kFields);
+
+  template <class Visitor>
+  static constexpr void Visit(ftxui::Box box, int field, Visitor& visitor) {
+    int extra = box.y_max - box.y_min + 1 - kMinY;
+    int flex = (0 + ... + Children::kFlexY);
+    int y = box.y_min;
+    (VisitChild<Children>(box, y, extra, flex, field, visitor), ...);
+  }
+
+ private:
+  template <class Child, class Visitor>
+  static constexpr void VisitChild(ftxui::Box box,
+                                   int& y,
+                                   int& extra,
+                                   int& flex,
+                                   int& field,
+                                   Visitor& visitor) {
+    int added = 0;
+    if (extra > 0 && flex > 0) {
+      added = extra * Child::kFlexY / flex;
+      extra -= added;
+      flex -= Child::kFlexY;
+    }
+    ftxui::Box child = box;
+    child.y_min = y;
+    child.y_max = std::min(box.y_max, y + Child::kMinY + added - 1);
+    Child::Visit(child, field, visitor);
+    y += Child::kMinY + added;
+    field += Child::kFields;
+  }
+};
+
+// A border around |Content|, with |Title| drawn over its top edge.
+template <class Title, class Content>
+struct Window {
+  static constexpr int kMinX = std::max(Content::kMinX, Title::kMinX) + 2;
+  static constexpr int kMinY = Content::kMinY + 2;
+  static constexpr int kFlexX = Content::kFlexX;
+  static constexpr int kFlexY = Content::kFlexY;
+  static constexpr int kFields = Title::kFields + Content::kFields;
+
+  template <class Visitor>
+  static constexpr void Visit(ftxui::Box box, int field, Visitor& visitor) {
+    ftxui::Box inner = box;
+    inner.x_min++;
+    inner.x_max--;
+    inner.y_min++;
+    inner.y_max--;
+    Content::Visit(inner, field + Title::kFields, visitor);
+    visitor.Border(box);
+
+    ftxui::Box title = inner;
+    title.y_min = title.y_max = box.y_min;
+    Title::Visit(title, field, visitor);
+  }
+};
+
+template <class Child>
+struct Flex : Child {
+  static constexpr int kFlexX = 1;
+  static constexpr int kFlexY = 1;
+};
+
+template <class Child>
+struct Bold : Child {
+  template <class Visitor>
+  static constexpr void Visit(ftxui::Box box, int field, Visitor& visitor) {
+    Child::Visit(box, field, visitor);
+    visitor.Bold(box);
+  }
+};
+
+template <ftxui::Color::Palette16 kColor, class Child>
+struct Colored : Child {
+  template <class Visitor>
+  static constexpr void Visit(ftxui::Box box, int field, Visitor& visitor) {
+    Child::Visit(box, field, visitor);
+    visitor.Color(box, kColor);
+  }
+};
+
+// Equivalent of size(WIDTH, LESS_THAN, kWidth).
+template <int kWidth, class Child>
+struct MaxWidth : Child {
+  static constexpr int kMinX = std::min(Child::kMinX, kWidth);
+
+  template <class Visitor>
+  static constexpr void Visit(ftxui::Box box, int field, Visitor& visitor) {
+    box.x_max = std::min(box.x_max, box.x_min + kWidth - 1);
+    Child::Visit(box, field, visitor);
+  }
+};
+
+}  // namespace layout
+
+// A Screen holding a static layout drawn at one width, whose fields are
+// rewritten every frame.
+//
+// Usage:
+//   StaticLayout<Layout> dashboard(80);
+//   for (;;) {
+//     Screen& screen = dashboard.Render({"3", "2", "9"});
+//     ...
+//   }
+template <class Layout>
+class StaticLayout {
+ public:
+  static constexpr int kFields = Layout::kFields;
+  using Boxes = std::array<ftxui::Box, kFields>;
+  using Values = std::array<std::string_view, kFields>;
+
+  // Returns the box of every field when laid out |width| columns wide. Usable
+  // in constant expressions:
+  //   constexpr auto boxes = StaticLayout<Layout>::Place(80);
+  static constexpr Boxes Place(int width) {
+    Placer placer;
+    Layout::Visit(Root(width), 0, placer);
+    return placer.boxes;
+  }
+
+  explicit StaticLayout(int width)
+      : boxes_(Place(width)), screen_(width, Layout::kMinY) {
+    Painter painter{screen_};
+    Layout::Visit(Root(width), 0, painter);
+  }
+
+  // Writes |values| into their fields, padded with spaces and clipped to the
+  // width of the field.
+  ftxui::Screen& Render(const Values& values) {
+    for (int i = 0; i < kFields; ++i) {
+      const ftxui::Box& box = boxes_[i];
+      std::string_view value = values[i];
+      size_t index = 0;
+      for (int x = box.x_min; x <= box.x_max; ++x, ++index) {
+        char c = index < value.size() ? value[index] : ' ';
+        screen_.PixelAt(x, box.y_min).character.assign(1, c);
+      }
+    }
+    return screen_;
+  }
+
+  const Boxes& boxes() const { return boxes_; }
+  ftxui::Screen& screen() { return screen_; }
+
+ private:
+  static constexpr ftxui::Box Root(int width) {
+    ftxui::Box box;
+    box.x_min = 0;
+    box.x_max = width - 1;
+    box.y_min = 0;
+    box.y_max = Layout::kMinY - 1;
+    return box;
+  }
+
+  // Records the boxes of the fields, in constant expressions.
+  struct Placer {
+    Boxes boxes = {};
+    constexpr void Text(ftxui::Box, std::string_view) {}
+    constexpr void Field(int index, ftxui::Box box) { boxes[index] = box; }
+    constexpr void Border(ftxui::Box) {}
+    constexpr void Bold(ftxui::Box) {}
+    constexpr void Color(ftxui::Box, ftxui::Color::Palette16) {}
+  };
+
+  // Draws the static parts of the layout.
+  struct Painter {
+    ftxui::Screen& screen;
+
+    void Text(ftxui::Box box, std::string_view text) {
+      int x = box.x_min;
+      for (size_t i = 0; i < text.size() && x <= box.x_max; ++i, ++x)
+        screen.PixelAt(x, box.y_min).character.assign(1, text[i]);
+    }
+
+    void Field(int, ftxui::Box) {}
+
+    void Border(ftxui::Box box) {
+      if (box.x_min >= box.x_max || box.y_min >= box.y_max)
+        return;
+      for (int x = box.x_min + 1; x < box.x_max; ++x) {
+        screen.at(x, box.y_min) = "─";
+        screen.at(x, box.y_max) = "─";
+      }
+      for (int y = box.y_min + 1; y < box.y_max; ++y) {
+        screen.at(box.x_min, y) = "│";
+        screen.at(box.x_max, y) = "│";
+      }
+      screen.at(box.x_min, box.y_min) = "┌";
+      screen.at(box.x_max, box.y_min) = "┐";
+      screen.at(box.x_min, box.y_max) = "└";
+      screen.at(box.x_max, box.y_max) = "┘";
+    }
+
+    void Bold(ftxui::Box box) {
+      for (int y = box.y_min; y <= box.y_max; ++y) {
+        for (int x = box.x_min; x <= box.x_max; ++x)
+          screen.PixelAt(x, y).bold = true;
+      }
+    }
+
+    void Color(ftxui::Box box, ftxui::Color::Palette16 color) {
+      for (int y = box.y_min; y <= box.y_max; ++y) {
+        for (int x = box.x_min; x <= box.x_max; ++x)
+          screen.PixelAt(x, y).foreground_color = color;
+      }
+    }
+  };
+
+  Boxes boxes_;
+  ftxui::Screen screen_;
+};
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_STATIC_LAYOUT_HPP
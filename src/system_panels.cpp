@@ -0,0 +1,160 @@
+#include "system_panels.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include "interned_text.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+// Cores listed one per line; the others are averaged on one more line.
+constexpr size_t kMaxCores = 8;
+// Samples shown by a graph.
+constexpr size_t kGraphWidth = 12;
+
+// The last samples of |history|, as bars scaled to |max|.
+Element Graph(const History& history, float max) {
+  static const char* const kBars[] = {" ", "▁", "▂", "▃", "▄",
+                                      "▅", "▆", "▇", "█"};
+  std::string bars;
+  size_t shown = std::min(history.size(), kGraphWidth);
+  for (size_t i = shown; i < kGraphWidth; ++i)
+    bars += ' ';
+  for (size_t i = history.size() - shown; i < history.size(); ++i) {
+    float ratio = max > 0 ? std::clamp(history[i] / max, 0.f, 1.f) : 0.f;
+    bars += kBars[static_cast<int>(ratio * 8 + 0.5f)];
+  }
+  return text(std::move(bars));
+}
+
+float Last(const History& history) {
+  return history.empty() ? 0.f : history.back();
+}
+
+float Max(const History& history) {
+  float max = 0;
+  for (size_t i = 0; i < history.size(); ++i)
+    max = std::max(max, history[i]);
+  return max;
+}
+
+std::string Percent(float value) {
+  char buffer[16];
+  std::snprintf(buffer, sizeof(buffer), " %3.0f%%", value);
+  return buffer;
+}
+
+// |bytes| per second, with a binary unit.
+std::string Rate(float bytes) {
+  static const char kUnits[] = "BKMGT";
+  int unit = 0;
+  while (bytes >= 1024 && unit < 4) {
+    bytes /= 1024;
+    unit++;
+  }
+  char buffer[16];
+  std::snprintf(buffer, sizeof(buffer), " %5.1f%c/s", bytes, kUnits[unit]);
+  return buffer;
+}
+
+Element Line(const InternedText& name, const History& history, float max,
+             std::string value) {
+  return hbox({label(name), Graph(history, max), text(std::move(value))});
+}
+
+Element CpuPanel(const CpuCollector& cpu) {
+  static const InternedText& kTitle = Intern(L" CPU ");
+  static const InternedText& kOthers = Intern(L"others ");
+
+  const std::vector<History>& cores = cpu.cores();
+  Elements lines;
+  for (size_t i = 0; i < cores.size() && i < kMaxCores; ++i) {
+    char name[16];
+    std::snprintf(name, sizeof(name), "cpu%-3zu", i);
+    lines.push_back(hbox({text(name), Graph(cores[i], 100),
+                          text(Percent(Last(cores[i])))}));
+  }
+  if (cores.size() > kMaxCores) {
+    float sum = 0;
+    for (size_t i = kMaxCores; i < cores.size(); ++i)
+      sum += Last(cores[i]);
+    lines.push_back(hbox({label(kOthers), text(std::to_string(
+                                              cores.size() - kMaxCores)),
+                          text(Percent(sum / (cores.size() - kMaxCores)))}));
+  }
+  return window(label(kTitle), vbox(std::move(lines)));
+}
+
+Element MemoryPanel(const MemoryCollector& memory) {
+  static const InternedText& kTitle = Intern(L" Memory ");
+  static const InternedText& kUsed = Intern(L"used ");
+
+  char total[32];
+  std::snprintf(total, sizeof(total), "%.1f / %.1f GiB",
+                memory.used_kb() / 1048576.0, memory.total_kb() / 1048576.0);
+  return window(label(kTitle),
+                vbox({
+                    Line(kUsed, memory.used(), 100,
+                         Percent(Last(memory.used()))),
+                    text(total) | dim,
+                }));
+}
+
+Element IoPanel(const IoCollector& io) {
+  static const InternedText& kTitle = Intern(L" I/O ");
+  static const InternedText& kRead = Intern(L"disk in  ");
+  static const InternedText& kWritten = Intern(L"disk out ");
+  static const InternedText& kReceived = Intern(L"net in   ");
+  static const InternedText& kSent = Intern(L"net out  ");
+
+  auto line = [](const InternedText& name, const History& history) {
+    return Line(name, history, Max(history), Rate(Last(history)));
+  };
+  return window(label(kTitle), vbox({
+                                   line(kRead, io.disk_read()),
+                                   line(kWritten, io.disk_written()),
+                                   line(kReceived, io.received()),
+                                   line(kSent, io.sent()),
+                               }));
+}
+
+Element ProcessPanel(const ProcessCollector& processes) {
+  static const InternedText& kTitle = Intern(L" Processes ");
+  static const InternedText& kTotal = Intern(L"total ");
+
+  const History& total = processes.total();
+  return window(
+      label(kTitle),
+      vbox({
+          Line(kTotal, total, std::max(100.f, Max(total)),
+               Percent(Last(total))),
+          text(std::to_string(processes.count()) + " processes") | dim,
+          text(std::string(processes.busiest_name()) +
+               Percent(processes.busiest_usage())) |
+              dim,
+      }));
+}
+
+}  // namespace
+
+void SystemMonitor::Sample() {
+  cpu_.Sample();
+  memory_.Sample();
+  io_.Sample();
+  processes_.Sample();
+}
+
+Element SystemPanels(const SystemMonitor& monitor) {
+  return hbox({
+      CpuPanel(monitor.cpu()),
+      vbox({MemoryPanel(monitor.memory()), ProcessPanel(monitor.processes())}),
+      IoPanel(monitor.io()),
+  });
+}
+
+}  // namespace app
@@ -0,0 +1,34 @@
+#ifndef FTXUI_STARTER_SYSTEM_PANELS_HPP
+#define FTXUI_STARTER_SYSTEM_PANELS_HPP
+
+#include "ftxui/dom/elements.hpp"
+#include "procfs.hpp"
+
+namespace app {
+
+// The procfs collectors behind the system panels, sampled together.
+class SystemMonitor {
+ public:
+  // To be called at a steady rate: histories hold 64 samples, 6.4 seconds
+  // at 10 Hz.
+  void Sample();
+
+  const CpuCollector& cpu() const { return cpu_; }
+  const MemoryCollector& memory() const { return memory_; }
+  const IoCollector& io() const { return io_; }
+  const ProcessCollector& processes() const { return processes_; }
+
+ private:
+  CpuCollector cpu_;
+  MemoryCollector memory_;
+  IoCollector io_;
+  ProcessCollector processes_;
+};
+
+// Windows in the style of Summary(): CPU usage per core, memory, disk and
+// network throughput, and processes, each with a graph of its history.
+ftxui::Element SystemPanels(const SystemMonitor& monitor);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_SYSTEM_PANELS_HPP
@@ -0,0 +1,110 @@
+#include "terminal_input.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+constexpr char kEscape = '\x1B';
+
+// Length of the UTF-8 sequence starting with |lead|.
+size_t Utf8Length(unsigned char lead) {
+  if (lead >= 0xF0)
+    return 4;
+  if (lead >= 0xE0)
+    return 3;
+  if (lead >= 0xC0)
+    return 2;
+  return 1;
+}
+
+}  // namespace
+
+void InputParser::Feed(std::string_view data, std::vector<Event>& events) {
+  pending_.append(data.data(), data.size());
+  std::string_view input = pending_;
+
+  size_t i = 0;
+  while (i < input.size()) {
+    size_t length = 0;
+    if (input[i] == kEscape) {
+      if (i + 1 == input.size()) {
+        // Wait for more input, or for FlushEscape().
+      } else if (input[i + 1] == '[') {
+        // Control Sequence: ESC [ parameters final, with a final byte in
+        // 0x40-0x7E.
+        for (size_t j = i + 2; j < input.size() && !length; ++j) {
+          if (input[j] >= 0x40 && input[j] <= 0x7E)
+            length = j - i + 1;
+        }
+      } else if (input[i + 1] == 'O') {
+        if (i + 2 < input.size())
+          length = 3;
+      } else {
+        // Alt + key.
+        length = 2;
+      }
+      if (!length)
+        break;
+      events.push_back(Event::Special(std::string(input.substr(i, length))));
+    } else {
+      unsigned char c = input[i];
+      length = Utf8Length(c);
+      if (i + length > input.size())
+        break;
+      if (c < 0x20 || c == 0x7F)
+        events.push_back(Event::Special(std::string(1, input[i])));
+      else
+        events.push_back(
+            Event::Character(std::string(input.substr(i, length))));
+    }
+    i += length;
+  }
+
+  pending_.erase(0, i);
+}
+
+void InputParser::FlushEscape(std::vector<Event>& events) {
+  if (!escape_pending())
+    return;
+  events.push_back(Event::Escape);
+  pending_.erase(0, 1);
+  Feed({}, events);
+}
+
+TerminalMode::TerminalMode() {
+  if (tcgetattr(STDIN_FILENO, &saved_) == 0) {
+    termios raw = saved_;
+    raw.c_lflag &= ~(ICANON | ECHO);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    restore_ = tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
+  }
+  // Alternate screen, hidden cursor.
+  WriteAll(STDOUT_FILENO, "\x1B[?1049h\x1B[?25l");
+}
+
+TerminalMode::~TerminalMode() {
+  WriteAll(STDOUT_FILENO, "\x1B[0m\x1B[?25h\x1B[?1049l");
+  if (restore_)
+    tcsetattr(STDIN_FILENO, TCSANOW, &saved_);
+}
+
+void WriteAll(int fd, std::string_view data) {
+  while (!data.empty()) {
+    ssize_t n = write(fd, data.data(), data.size());
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      return;
+    }
+    data.remove_prefix(n);
+  }
+}
+
+}  // namespace app
@@ -0,0 +1,60 @@
+#ifndef FTXUI_STARTER_TERMINAL_INPUT_HPP
+#define FTXUI_STARTER_TERMINAL_INPUT_HPP
+
+#include <termios.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ftxui/component/event.hpp"
+
+namespace app {
+
+// Splits the bytes typed in a terminal into ftxui::Events: characters, and
+// escape sequences for special keys (ftxui::Event::ArrowUp, ...).
+class InputParser {
+ public:
+  // How long an escape character waits for the rest of its sequence before
+  // being taken for the Escape key.
+  static constexpr std::chrono::milliseconds kEscapeTimeout{50};
+
+  // Appends to |events| the events encoded in |data|. A sequence cut at the
+  // end of |data| is kept, and completed by the next call. So is a lone
+  // escape character, which may start a sequence cut by the read, as happens
+  // over ssh.
+  void Feed(std::string_view data, std::vector<ftxui::Event>& events);
+
+  // Whether an escape character is waiting for the rest of its sequence.
+  bool escape_pending() const {
+    return !pending_.empty() && pending_[0] == '\x1B';
+  }
+  // Takes the escape character kept by Feed() for the Escape key, and parses
+  // what followed it. To be called when kEscapeTimeout passed without input.
+  void FlushEscape(std::vector<ftxui::Event>& events);
+
+ private:
+  std::string pending_;
+};
+
+// Sets up the terminal for a full screen program for as long as it lives:
+// unbuffered input without echo, alternate screen and hidden cursor.
+class TerminalMode {
+ public:
+  TerminalMode();
+  ~TerminalMode();
+  TerminalMode(const TerminalMode&) = delete;
+  TerminalMode& operator=(const TerminalMode&) = delete;
+
+ private:
+  termios saved_;
+  bool restore_ = false;
+};
+
+// Writes all of |data| to |fd|, retrying on partial writes.
+void WriteAll(int fd, std::string_view data);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_TERMINAL_INPUT_HPP
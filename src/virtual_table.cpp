@@ -0,0 +1,185 @@
+#include "virtual_table.hpp"
+
+#include <algorithm>
+
+#include "ftxui/dom/node.hpp"
+#include "ftxui/screen/string.hpp"
+
+namespace app {
+
+using namespace ftxui;
+
+namespace {
+
+// Rows measured to size the columns of a table, spread evenly.
+constexpr size_t kSampleRows = 256;
+
+}  // namespace
+
+void TableState::ScrollBy(long rows) {
+  if (rows < 0 && static_cast<size_t>(-rows) > first_row_)
+    first_row_ = 0;
+  else
+    first_row_ += rows;
+}
+
+void TableState::ResetWidths() {
+  widths_.clear();
+  sampled_ = false;
+}
+
+class TableNode : public Node {
+ public:
+  TableNode(std::vector<TableColumn> columns,
+            TableRows rows,
+            TableState* state)
+      : columns_(std::move(columns)),
+        rows_(std::move(rows)),
+        state_(state),
+        scratch_(columns_.size()) {
+    for (const TableColumn& column : columns_)
+      headers_.push_back(column.header);
+  }
+
+  void ComputeRequirement() override {
+    TableState& state = *state_;
+    if (state.widths_.size() != columns_.size()) {
+      state.widths_.assign(columns_.size(), 0);
+      state.sampled_ = false;
+    }
+    for (size_t i = 0; i < columns_.size(); ++i) {
+      Grow(i, std::max(columns_[i].min_width,
+                       string_width(columns_[i].header)));
+    }
+
+    // Resample when the row count changed by more than an eighth.
+    size_t sampled = state.sampled_count_;
+    size_t delta = rows_.count > sampled ? rows_.count - sampled
+                                         : sampled - rows_.count;
+    if (!state.sampled_ || delta > sampled / 8)
+      Sample();
+
+    // Size the columns for the rows about to be shown, assuming the table
+    // keeps its height.
+    Format(std::max(state.visible_rows_, 1));
+
+    requirement_.min_x = 0;
+    for (int width : state.widths_)
+      requirement_.min_x += width;
+    requirement_.min_x += static_cast<int>(columns_.size()) - 1;
+    // Header, separator, and at least one row.
+    requirement_.min_y = 3;
+    requirement_.flex_grow_y = 1;
+    requirement_.flex_shrink_y = 1;
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    state_->visible_rows_ = std::max(0, box.y_max - box.y_min + 1 - 2);
+  }
+
+  void Render(Screen& screen) override {
+    Format(state_->visible_rows_);
+
+    int y = box_.y_min;
+    if (y > box_.y_max)
+      return;
+    DrawRow(screen, y, headers_, true);
+
+    if (++y > box_.y_max)
+      return;
+    for (int x = box_.x_min; x <= box_.x_max; ++x)
+      screen.at(x, y) = "─";
+
+    for (int i = 0; i < formatted_count_ && ++y <= box_.y_max; ++i)
+      DrawRow(screen, y, formatted_[i], false);
+  }
+
+ private:
+  // Formats the |count| rows starting at the scroll position, unless they
+  // already are.
+  void Format(int count) {
+    TableState& state = *state_;
+    size_t last_first = rows_.count > static_cast<size_t>(count)
+                            ? rows_.count - count
+                            : 0;
+    state.first_row_ = std::min(state.first_row_, last_first);
+    count = static_cast<int>(
+        std::min<size_t>(count, rows_.count - state.first_row_));
+
+    if (state.first_row_ == formatted_first_ && count <= formatted_count_)
+      return;
+
+    if (formatted_.size() < static_cast<size_t>(count))
+      formatted_.resize(count, std::vector<std::string>(columns_.size()));
+    for (int i = 0; i < count; ++i) {
+      rows_.format(state.first_row_ + i, formatted_[i]);
+      Measure(formatted_[i]);
+    }
+    formatted_first_ = state.first_row_;
+    formatted_count_ = count;
+  }
+
+  void Sample() {
+    TableState& state = *state_;
+    size_t step = std::max<size_t>(1, rows_.count / kSampleRows);
+    for (size_t row = 0; row < rows_.count; row += step) {
+      rows_.format(row, scratch_);
+      Measure(scratch_);
+    }
+    if (rows_.count > 0) {
+      rows_.format(rows_.count - 1, scratch_);
+      Measure(scratch_);
+    }
+    state.sampled_count_ = rows_.count;
+    state.sampled_ = true;
+  }
+
+  void Measure(const std::vector<std::string>& cells) {
+    for (size_t i = 0; i < columns_.size() && i < cells.size(); ++i)
+      Grow(i, string_width(cells[i]));
+  }
+
+  void Grow(size_t column, int width) {
+    int& current = state_->widths_[column];
+    current = std::max(current, std::min(width, columns_[column].max_width));
+  }
+
+  void DrawRow(Screen& screen,
+               int y,
+               const std::vector<std::string>& cells,
+               bool bold) {
+    int x = box_.x_min;
+    for (size_t i = 0; i < columns_.size() && x <= box_.x_max; ++i) {
+      int width = state_->widths_[i];
+      std::vector<std::string> glyphs = Utf8ToGlyphs(cells[i]);
+      int length = std::min(static_cast<int>(glyphs.size()), width);
+      int start = columns_[i].align_right ? x + width - length : x;
+      for (int j = 0; j < length && start + j <= box_.x_max; ++j) {
+        Pixel& pixel = screen.PixelAt(start + j, y);
+        pixel.character = glyphs[j];
+        pixel.bold = bold;
+      }
+      x += width + 1;
+    }
+  }
+
+  std::vector<TableColumn> columns_;
+  TableRows rows_;
+  TableState* state_;
+
+  std::vector<std::string> headers_;
+  std::vector<std::vector<std::string>> formatted_;
+  size_t formatted_first_ = 0;
+  int formatted_count_ = -1;
+  std::vector<std::string> scratch_;
+};
+
+Element virtual_table(std::vector<TableColumn> columns,
+                      TableRows rows,
+                      TableState* state) {
+  return std::make_shared<TableNode>(std::move(columns), std::move(rows),
+                                     state);
+}
+
+}  // namespace app
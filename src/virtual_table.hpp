@@ -0,0 +1,65 @@
+#ifndef FTXUI_STARTER_VIRTUAL_TABLE_HPP
+#define FTXUI_STARTER_VIRTUAL_TABLE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ftxui/dom/elements.hpp"
+
+namespace app {
+
+struct TableColumn {
+  std::string header;
+  // Bounds of the width of the column, in cells. Longer cells are truncated.
+  int min_width = 1;
+  int max_width = 32;
+  bool align_right = false;
+};
+
+// The rows of a table, fetched on demand.
+struct TableRows {
+  size_t count = 0;
+  // Writes the cells of |row| into |cells|, which holds one string per
+  // column. The strings are reused from one call to the next.
+  std::function<void(size_t row, std::vector<std::string>& cells)> format;
+};
+
+// What a table remembers from one frame to the next: the scroll position and
+// the column widths. Widths come from a sample of the rows, refreshed when
+// the row count changes significantly, and from the rows shown so far. They
+// only grow, so that columns do not jump while scrolling.
+class TableState {
+ public:
+  size_t first_row() const { return first_row_; }
+  // Number of rows shown by the last frame.
+  int visible_rows() const { return visible_rows_; }
+
+  void ScrollTo(size_t row) { first_row_ = row; }
+  void ScrollBy(long rows);
+
+  // Forgets the column widths, for instance after the rows were filtered.
+  void ResetWidths();
+
+ private:
+  friend class TableNode;
+
+  size_t first_row_ = 0;
+  int visible_rows_ = 0;
+  std::vector<int> widths_;
+  // Row count when the rows were last sampled.
+  size_t sampled_count_ = 0;
+  bool sampled_ = false;
+};
+
+// A table showing the rows of |rows| in the space it is given, scrolled as
+// told by |state|. Only the visible rows are formatted, so the cost of a frame
+// does not depend on the number of rows.
+ftxui::Element virtual_table(std::vector<TableColumn> columns,
+                             TableRows rows,
+                             TableState* state);
+
+}  // namespace app
+
+#endif  // FTXUI_STARTER_VIRTUAL_TABLE_HPP